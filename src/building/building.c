@@ -1,14 +1,17 @@
 #include "building.h"
 
 #include "building/building_state.h"
+#include "building/list.h"
 #include "building/properties.h"
 #include "building/storage.h"
 #include "city/buildings.h"
 #include "city/population.h"
 #include "city/warning.h"
+#include "core/hash.h"
 #include "figure/formation_legion.h"
 #include "game/resource.h"
 #include "game/undo.h"
+#include "map/building.h"
 #include "map/building_tiles.h"
 #include "map/desirability.h"
 #include "map/elevation.h"
@@ -70,6 +73,11 @@ building *building_create(building_type type, int x, int y)
     memset(&(b->data), 0, sizeof(b->data));
 
     b->state = BUILDING_STATE_CREATED;
+    building_list_storage_invalidate();
+    if (building_is_house(type)) {
+        // the map may still refer to this building from before it was deleted
+        map_building_invalidate_houses();
+    }
     b->faction_id = 1;
     b->unknown_value = city_buildings_unknown_value();
     b->type = type;
@@ -322,6 +330,8 @@ void building_clear_all(void)
     extra.created_sequence = 0;
     extra.incorrect_houses = 0;
     extra.unfixable_houses = 0;
+    building_list_storage_invalidate();
+    map_building_invalidate_houses();
 }
 
 void building_save_state(buffer *buf, buffer *highest_id, buffer *highest_id_ever,
@@ -353,4 +363,14 @@ void building_load_state(buffer *buf, buffer *highest_id, buffer *highest_id_eve
 
     extra.incorrect_houses = buffer_read_i32(corrupt_houses);
     extra.unfixable_houses = buffer_read_i32(corrupt_houses);
+    building_list_storage_invalidate();
+    map_building_invalidate_houses();
+}
+
+uint64_t building_hash_state(void)
+{
+    uint64_t hash = 0;
+    hash = hash_xxh64(all_buildings, sizeof(all_buildings), hash);
+    hash = hash_xxh64(&extra, sizeof(extra), hash);
+    return hash;
 }
@@ -7,14 +7,13 @@
 #define MAX_BUILDINGS 2000
 
 typedef struct {
+    // Fields checked by the passes over all buildings come first, so those passes read fewer cache lines
     int id;
 
     unsigned char state;
-    unsigned char faction_id;
-    unsigned char unknown_value;
     unsigned char size;
-    unsigned char house_is_merged;
     unsigned char house_size;
+    unsigned char house_is_merged;
     unsigned char x;
     unsigned char y;
     short grid_offset;
@@ -27,14 +26,28 @@ typedef struct {
         short fort_figure_type;
         short native_meeting_center_id;
     } subtype;
+    signed char desirability;
+    unsigned char is_deleted;
+    unsigned char is_adjacent_to_water;
     unsigned char road_network_id;
-    unsigned short created_sequence;
-    short houses_covered;
-    short percentage_houses_covered;
+    unsigned char has_road_access;
+    unsigned char has_water_access;
+    unsigned char has_well_access;
+    unsigned char labor_category;
+    short distance_from_entry;
     short house_population;
     short house_population_room;
-    short distance_from_entry;
     short house_highest_population;
+    short num_workers;
+    short loads_stored;
+    short prev_part_building_id;
+    short next_part_building_id;
+
+    unsigned char faction_id;
+    unsigned char unknown_value;
+    unsigned short created_sequence;
+    short houses_covered;
+    short percentage_houses_covered;
     short house_unreachable_ticks;
     unsigned char road_access_x;
     unsigned char road_access_y;
@@ -44,15 +57,7 @@ typedef struct {
     short figure_id4; // tower ballista or burning ruin prefect
     unsigned char figure_spawn_delay;
     unsigned char figure_roam_direction;
-    unsigned char has_water_access;
-    short prev_part_building_id;
-    short next_part_building_id;
-    short loads_stored;
-    unsigned char has_well_access;
-    short num_workers;
-    unsigned char labor_category;
     unsigned char output_resource_id;
-    unsigned char has_road_access;
     unsigned char house_criminal_active;
     short damage_risk;
     short fire_risk;
@@ -128,9 +133,6 @@ typedef struct {
     int tax_income_or_storage;
     unsigned char house_days_without_food;
     unsigned char ruin_has_plague;
-    signed char desirability;
-    unsigned char is_deleted;
-    unsigned char is_adjacent_to_water;
     unsigned char storage_id;
     union {
         signed char house_happiness;
@@ -171,4 +173,6 @@ void building_save_state(buffer *buf, buffer *highest_id, buffer *highest_id_eve
 void building_load_state(buffer *buf, buffer *highest_id, buffer *highest_id_ever,
                          buffer *sequence, buffer *corrupt_houses);
 
+uint64_t building_hash_state(void);
+
 #endif // BUILDING_BUILDING_H
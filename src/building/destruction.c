@@ -1,5 +1,6 @@
 #include "destruction.h"
 
+#include "building/list.h"
 #include "city/message.h"
 #include "city/population.h"
 #include "city/ratings.h"
@@ -48,6 +49,7 @@ static void destroy_on_fire(building *b, int plagued)
         b->state = BUILDING_STATE_DELETED_BY_GAME;
     } else {
         b->type = BUILDING_BURNING_RUIN;
+        building_list_storage_invalidate();
         b->figure_id4 = 0;
         b->tax_income_or_storage = 0;
         b->fire_duration = (b->house_figure_generation_delay & 7) + 1;
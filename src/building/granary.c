@@ -1,6 +1,7 @@
 #include "granary.h"
 
 #include "building/destruction.h"
+#include "building/list.h"
 #include "building/model.h"
 #include "building/storage.h"
 #include "building/warehouse.h"
@@ -177,8 +178,10 @@ void building_granaries_calculate_stocks(void)
     non_getting_granaries.total_storage_fruit = 0;
     non_getting_granaries.total_storage_meat = 0;
 
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY) {
             continue;
         }
@@ -204,7 +207,7 @@ void building_granaries_calculate_stocks(void)
             non_getting_granaries.total_storage_meat += b->data.granary.resource_stored[RESOURCE_MEAT];
         }
         if (total_non_getting > ONE_LOAD) {
-            non_getting_granaries.building_ids[non_getting_granaries.num_items] = i;
+            non_getting_granaries.building_ids[non_getting_granaries.num_items] = b->id;
             if (non_getting_granaries.num_items < MAX_GRANARIES - 2) {
                 non_getting_granaries.num_items++;
             }
@@ -226,8 +229,10 @@ int building_granary_for_storing(int x, int y, int resource, int distance_from_e
     }
     int min_dist = INFINITE;
     int min_building_id = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY) {
             continue;
         }
@@ -251,7 +256,7 @@ int building_granary_for_storing(int x, int y, int resource, int distance_from_e
                 b->x + 1, b->y + 1, x, y, distance_from_entry, b->distance_from_entry);
             if (dist < min_dist) {
                 min_dist = dist;
-                min_building_id = i;
+                min_building_id = b->id;
             }
         }
     }
@@ -275,8 +280,10 @@ int building_getting_granary_for_storing(int x, int y, int resource, int distanc
     }
     int min_dist = INFINITE;
     int min_building_id = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY) {
             continue;
         }
@@ -297,7 +304,7 @@ int building_getting_granary_for_storing(int x, int y, int resource, int distanc
                 b->x + 1, b->y + 1, x, y, distance_from_entry, b->distance_from_entry);
             if (dist < min_dist) {
                 min_dist = dist;
-                min_building_id = i;
+                min_building_id = b->id;
             }
         }
     }
@@ -374,8 +381,10 @@ void building_granary_bless(void)
 {
     int min_stored = INFINITE;
     building *min_building = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY) {
             continue;
         }
@@ -1,11 +1,21 @@
 #include "list.h"
 
+#include "building/building.h"
+
 #include <string.h>
 
 #define MAX_SMALL 500
 #define MAX_LARGE 2000
 #define MAX_BURNING 500
 
+enum {
+    STORAGE_WAREHOUSE = 0,
+    STORAGE_WAREHOUSE_SPACE = 1,
+    STORAGE_GRANARY = 2,
+    STORAGE_MAX = 3,
+    STORAGE_NONE = -1
+};
+
 static struct {
     struct {
         int size;
@@ -20,6 +30,11 @@ static struct {
         int items[MAX_BURNING];
         int total;
     } burning;
+    struct {
+        int is_valid;
+        int size[STORAGE_MAX];
+        int items[STORAGE_MAX][MAX_BUILDINGS];
+    } storage;
 } data;
 
 void building_list_small_clear(void)
@@ -95,6 +110,64 @@ const int *building_list_burning_items(void)
     return data.burning.items;
 }
 
+static int storage_index(building_type type)
+{
+    switch (type) {
+        case BUILDING_WAREHOUSE:
+            return STORAGE_WAREHOUSE;
+        case BUILDING_WAREHOUSE_SPACE:
+            return STORAGE_WAREHOUSE_SPACE;
+        case BUILDING_GRANARY:
+            return STORAGE_GRANARY;
+        default:
+            return STORAGE_NONE;
+    }
+}
+
+static void update_storage(void)
+{
+    if (data.storage.is_valid) {
+        return;
+    }
+    for (int i = 0; i < STORAGE_MAX; i++) {
+        data.storage.size[i] = 0;
+    }
+    // The lists may still hold buildings that changed type since, so callers check the type as well
+    for (int i = 1; i < MAX_BUILDINGS; i++) {
+        building *b = building_get(i);
+        int index = storage_index(b->type);
+        if (b->state != BUILDING_STATE_UNUSED && index != STORAGE_NONE) {
+            data.storage.items[index][data.storage.size[index]++] = i;
+        }
+    }
+    data.storage.is_valid = 1;
+}
+
+void building_list_storage_invalidate(void)
+{
+    data.storage.is_valid = 0;
+}
+
+int building_list_storage_size(building_type type)
+{
+    int index = storage_index(type);
+    if (index == STORAGE_NONE) {
+        return 0;
+    }
+    update_storage();
+    return data.storage.size[index];
+}
+
+const int *building_list_storage_items(building_type type)
+{
+    int index = storage_index(type);
+    if (index == STORAGE_NONE) {
+        return 0;
+    }
+    update_storage();
+    return data.storage.items[index];
+}
+
 void building_list_save_state(buffer *small, buffer *large, buffer *burning, buffer *burning_totals)
 {
     for (int i = 0; i < MAX_SMALL; i++) {
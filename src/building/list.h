@@ -1,6 +1,7 @@
 #ifndef BUILDING_LIST_H
 #define BUILDING_LIST_H
 
+#include "building/type.h"
 #include "core/buffer.h"
 
 /**
@@ -63,6 +64,26 @@ int building_list_burning_size(void);
 
 const int *building_list_burning_items(void);
 
+/**
+ * Marks the storage lists as outdated, to be called when a building is created, restored or changes type
+ */
+void building_list_storage_invalidate(void);
+
+/**
+ * Returns the number of storage buildings of the given type
+ * @param type Building type: warehouse, warehouse space or granary
+ * @return List size
+ */
+int building_list_storage_size(building_type type);
+
+/**
+ * Returns the storage buildings of the given type, ordered by building ID.
+ * The list may contain buildings that are no longer in use, so check the state.
+ * @param type Building type: warehouse, warehouse space or granary
+ * @return List of building IDs
+ */
+const int *building_list_storage_items(building_type type);
+
 void building_list_save_state(buffer *small, buffer *large, buffer *burning, buffer *burning_totals);
 
 void building_list_load_state(buffer *small, buffer *large, buffer *burning, buffer *burning_totals);
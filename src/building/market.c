@@ -1,5 +1,6 @@
 #include "market.h"
 
+#include "building/list.h"
 #include "building/warehouse.h"
 #include "city/resource.h"
 #include "core/calc.h"
@@ -62,6 +63,22 @@ static void update_good_resource(struct resource_data *data, resource_type resou
     }
 }
 
+static int get_storage_distance(const building *market, const building *b, building_type type)
+{
+    if (b->state != BUILDING_STATE_IN_USE || b->type != type) {
+        return -1;
+    }
+    if (!b->has_road_access || b->distance_from_entry <= 0 ||
+        b->road_network_id != market->road_network_id) {
+        return -1;
+    }
+    int distance = calc_maximum_distance(market->x, market->y, b->x, b->y);
+    if (distance >= 40) {
+        return -1;
+    }
+    return distance;
+}
+
 int building_market_get_storage_destination(building *market)
 {
     struct resource_data resources[INVENTORY_MAX];
@@ -70,38 +87,35 @@ int building_market_get_storage_destination(building *market)
         resources[i].num_buildings = 0;
         resources[i].distance = 40;
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        if (b->type != BUILDING_GRANARY && b->type != BUILDING_WAREHOUSE) {
-            continue;
-        }
-        if (!b->has_road_access || b->distance_from_entry <= 0 ||
-            b->road_network_id != market->road_network_id) {
-            continue;
-        }
-        int distance = calc_maximum_distance(market->x, market->y, b->x, b->y);
-        if (distance >= 40) {
-            continue;
-        }
-        if (b->type == BUILDING_GRANARY) {
-            if (scenario_property_rome_supplies_wheat()) {
+    if (!scenario_property_rome_supplies_wheat()) {
+        const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+        int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+        for (int i = 0; i < num_granaries; i++) {
+            building *b = building_get(granaries[i]);
+            int distance = get_storage_distance(market, b, BUILDING_GRANARY);
+            if (distance < 0) {
                 continue;
             }
             update_food_resource(&resources[INVENTORY_WHEAT], RESOURCE_WHEAT, b, distance);
             update_food_resource(&resources[INVENTORY_VEGETABLES], RESOURCE_VEGETABLES, b, distance);
             update_food_resource(&resources[INVENTORY_FRUIT], RESOURCE_FRUIT, b, distance);
             update_food_resource(&resources[INVENTORY_MEAT], RESOURCE_MEAT, b, distance);
-        } else if (b->type == BUILDING_WAREHOUSE) {
-            // goods
-            update_good_resource(&resources[INVENTORY_WINE], RESOURCE_WINE, b, distance);
-            update_good_resource(&resources[INVENTORY_OIL], RESOURCE_OIL, b, distance);
-            update_good_resource(&resources[INVENTORY_POTTERY], RESOURCE_POTTERY, b, distance);
-            update_good_resource(&resources[INVENTORY_FURNITURE], RESOURCE_FURNITURE, b, distance);
         }
     }
+    // goods
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
+        int distance = get_storage_distance(market, b, BUILDING_WAREHOUSE);
+        if (distance < 0) {
+            continue;
+        }
+        update_good_resource(&resources[INVENTORY_WINE], RESOURCE_WINE, b, distance);
+        update_good_resource(&resources[INVENTORY_OIL], RESOURCE_OIL, b, distance);
+        update_good_resource(&resources[INVENTORY_POTTERY], RESOURCE_POTTERY, b, distance);
+        update_good_resource(&resources[INVENTORY_FURNITURE], RESOURCE_FURNITURE, b, distance);
+    }
 
     // update demands
     if (market->data.market.pottery_demand) {
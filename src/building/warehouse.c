@@ -1,6 +1,7 @@
 #include "warehouse.h"
 
 #include "building/count.h"
+#include "building/list.h"
 #include "building/model.h"
 #include "building/storage.h"
 #include "city/buildings.h"
@@ -253,8 +254,10 @@ int building_warehouse_for_storing(int src_building_id, int x, int y, int resour
 {
     int min_dist = 10000;
     int min_building_id = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *spaces = building_list_storage_items(BUILDING_WAREHOUSE_SPACE);
+    int num_spaces = building_list_storage_size(BUILDING_WAREHOUSE_SPACE);
+    for (int i = 0; i < num_spaces; i++) {
+        building *b = building_get(spaces[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE_SPACE) {
             continue;
         }
@@ -286,7 +289,7 @@ int building_warehouse_for_storing(int src_building_id, int x, int y, int resour
         }
         if (dist > 0 && dist < min_dist) {
             min_dist = dist;
-            min_building_id = i;
+            min_building_id = b->id;
         }
     }
     building *b = building_main(building_get(min_building_id));
@@ -302,12 +305,14 @@ int building_warehouse_for_getting(building *src, int resource, map_point *dst)
 {
     int min_dist = 10000;
     building *min_building = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE) {
             continue;
         }
-        if (i == src->id) {
+        if (b->id == src->id) {
             continue;
         }
         int loads_stored = 0;
@@ -348,8 +353,10 @@ static int determine_granary_accept_foods(int resources[RESOURCE_MAX_FOOD])
         resources[i] = 0;
     }
     int can_accept = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY || !b->has_road_access) {
             continue;
         }
@@ -378,8 +385,10 @@ static int determine_granary_get_foods(int resources[RESOURCE_MAX_FOOD])
         resources[i] = 0;
     }
     int can_get = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY || !b->has_road_access) {
             continue;
         }
@@ -3,6 +3,7 @@
 #include "city/constants.h"
 #include "city/data_private.h"
 #include "city/gods.h"
+#include "core/hash.h"
 #include "game/difficulty.h"
 #include "scenario/property.h"
 
@@ -1052,3 +1053,8 @@ void city_data_load_state(buffer *main, buffer *faction, buffer *faction_unknown
 
     load_entry_exit(entry_exit_xy, entry_exit_grid_offset);
 }
+
+uint64_t city_data_hash_state(void)
+{
+    return hash_xxh64(&city_data, sizeof(city_data), 0);
+}
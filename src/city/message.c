@@ -262,7 +262,10 @@ void city_message_process_queue(void)
 
 void city_message_sort_and_compact(void)
 {
-    for (int i = 0; i < MAX_MESSAGES; i++) {
+    // The messages are nearly always in order already: stop as soon as a pass changes nothing
+    int sorted = 0;
+    for (int i = 0; i < MAX_MESSAGES && !sorted; i++) {
+        sorted = 1;
         for (int a = 0; a < MAX_MESSAGES - 1; a++) {
             int swap = 0;
             if (data.messages[a].message_type) {
@@ -278,6 +281,7 @@ void city_message_sort_and_compact(void)
                 city_message tmp_message = data.messages[a];
                 data.messages[a] = data.messages[a+1];
                 data.messages[a+1] = tmp_message;
+                sorted = 0;
             }
         }
     }
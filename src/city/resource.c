@@ -2,6 +2,7 @@
 
 #include "building/building.h"
 #include "building/industry.h"
+#include "building/list.h"
 #include "building/model.h"
 #include "city/data_private.h"
 #include "core/calc.h"
@@ -171,8 +172,10 @@ void city_resource_calculate_warehouse_stocks(void)
         city_data.resource.space_in_warehouses[i] = 0;
         city_data.resource.stored_in_warehouses[i] = 0;
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
         if (b->state == BUILDING_STATE_IN_USE && b->type == BUILDING_WAREHOUSE) {
             b->has_road_access = 0;
             if (map_has_road_access(b->x, b->y, b->size, 0)) {
@@ -182,8 +185,10 @@ void city_resource_calculate_warehouse_stocks(void)
             }
         }
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *spaces = building_list_storage_items(BUILDING_WAREHOUSE_SPACE);
+    int num_spaces = building_list_storage_size(BUILDING_WAREHOUSE_SPACE);
+    for (int i = 0; i < num_spaces; i++) {
+        building *b = building_get(spaces[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE_SPACE) {
             continue;
         }
@@ -240,8 +245,10 @@ static void calculate_available_food(void)
     city_data.resource.granaries.understaffed = 0;
     city_data.resource.granaries.not_operating = 0;
     city_data.resource.granaries.not_operating_with_food = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *granaries = building_list_storage_items(BUILDING_GRANARY);
+    int num_granaries = building_list_storage_size(BUILDING_GRANARY);
+    for (int i = 0; i < num_granaries; i++) {
+        building *b = building_get(granaries[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_GRANARY) {
             continue;
         }
@@ -28,6 +28,8 @@ static const char *ini_keys[] = {
     "ui_highlight_legions",
     "ui_show_military_sidebar",
     "ui_show_speedrun_info",
+    "general_delta_autosave",
+    "screen_unlimited_speed_fps",
 };
 
 static const char *ini_string_keys[] = {
@@ -39,7 +41,8 @@ static char string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX];
 
 static int default_values[CONFIG_MAX_ENTRIES] = {
     [CONFIG_SCREEN_DISPLAY_SCALE] = 100,
-    [CONFIG_SCREEN_CURSOR_SCALE] = 100
+    [CONFIG_SCREEN_CURSOR_SCALE] = 100,
+    [CONFIG_SCREEN_UNLIMITED_SPEED_FPS] = 10
 };
 static const char default_string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX];
 
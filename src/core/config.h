@@ -20,6 +20,8 @@ typedef enum {
     CONFIG_UI_HIGHLIGHT_LEGIONS,
     CONFIG_UI_SHOW_MILITARY_SIDEBAR,
     CONFIG_UI_SHOW_SPEEDRUN_INFO,
+    CONFIG_GENERAL_DELTA_AUTOSAVE,
+    CONFIG_SCREEN_UNLIMITED_SPEED_FPS,
     CONFIG_MAX_ENTRIES
 } config_key;
 
@@ -5,15 +5,45 @@
 #include "core/string.h"
 #include "platform/file_manager.h"
 
+#include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define BASE_MAX_FILES 100
+#define INDEX_MIN_BUCKETS 16
+
+enum {
+    INDEX_NOT_FOUND = 0,
+    INDEX_FOUND = 1,
+    INDEX_UNAVAILABLE = 2
+};
+
+struct dir_index;
+
+typedef struct {
+    char *name;
+    uint32_t hash;
+    struct dir_index *subdir;
+} dir_index_entry;
+
+typedef struct dir_index {
+    dir_index_entry *entries;
+    int num_entries;
+    int max_entries;
+    int *buckets;
+    int num_buckets;
+} dir_index;
 
 static struct {
     dir_listing listing;
     int max_files;
     char *cased_filename;
+    struct {
+        dir_index *root;
+        int root_is_stale;
+        dir_index *building;
+    } index;
 } data;
 
 static void allocate_listing_files(int min, int max)
@@ -66,6 +96,8 @@ static int add_to_listing(const char *filename)
 
 const dir_listing *dir_find_files_with_extension(const char *extension)
 {
+    // Files may have been added from outside the game: pick them up on the next lookup
+    data.index.root_is_stale = 1;
     clear_dir_listing();
     platform_file_manager_list_directory_contents(0, TYPE_FILE, extension, add_to_listing);
     qsort(data.listing.files, data.listing.num_files, sizeof(char*), compare_lower);
@@ -80,6 +112,224 @@ const dir_listing *dir_find_all_subdirectories(void)
     return &data.listing;
 }
 
+static char fold_case(char c)
+{
+    return c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+static uint32_t hash_name(const char *name, size_t length)
+{
+    // FNV-1a over the lowercase name, so names that only differ in case end up in the same bucket
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (uint8_t) fold_case(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int names_equal(const char *indexed, const char *name, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (fold_case(indexed[i]) != fold_case(name[i])) {
+            return 0;
+        }
+    }
+    return indexed[length] == 0;
+}
+
+static void free_index(dir_index *index)
+{
+    if (!index) {
+        return;
+    }
+    for (int i = 0; i < index->num_entries; i++) {
+        free(index->entries[i].name);
+        free_index(index->entries[i].subdir);
+    }
+    free(index->entries);
+    free(index->buckets);
+    free(index);
+}
+
+static void insert_into_buckets(dir_index *index, int entry_id)
+{
+    int mask = index->num_buckets - 1;
+    int bucket = index->entries[entry_id].hash & mask;
+    while (index->buckets[bucket]) {
+        bucket = (bucket + 1) & mask;
+    }
+    // Bucket values are entry ids plus one, so zero means empty
+    index->buckets[bucket] = entry_id + 1;
+}
+
+static int rebuild_buckets(dir_index *index)
+{
+    int num_buckets = INDEX_MIN_BUCKETS;
+    while (num_buckets < 2 * index->num_entries) {
+        num_buckets *= 2;
+    }
+    int *buckets = calloc(num_buckets, sizeof(int));
+    if (!buckets) {
+        return 0;
+    }
+    free(index->buckets);
+    index->buckets = buckets;
+    index->num_buckets = num_buckets;
+    for (int i = 0; i < index->num_entries; i++) {
+        insert_into_buckets(index, i);
+    }
+    return 1;
+}
+
+static dir_index_entry *find_in_index(const dir_index *index, const char *name, size_t length)
+{
+    uint32_t hash = hash_name(name, length);
+    int mask = index->num_buckets - 1;
+    for (int bucket = hash & mask; index->buckets[bucket]; bucket = (bucket + 1) & mask) {
+        dir_index_entry *entry = &index->entries[index->buckets[bucket] - 1];
+        if (entry->hash == hash && names_equal(entry->name, name, length)) {
+            return entry;
+        }
+    }
+    return 0;
+}
+
+static int add_entry(dir_index *index, const char *name)
+{
+    size_t length = strlen(name);
+    if (index->num_entries >= index->max_entries) {
+        int max_entries = index->max_entries ? 2 * index->max_entries : INDEX_MIN_BUCKETS;
+        dir_index_entry *entries = realloc(index->entries, max_entries * sizeof(dir_index_entry));
+        if (!entries) {
+            return 0;
+        }
+        index->entries = entries;
+        index->max_entries = max_entries;
+    }
+    dir_index_entry *entry = &index->entries[index->num_entries];
+    entry->name = malloc(length + 1);
+    if (!entry->name) {
+        return 0;
+    }
+    memcpy(entry->name, name, length + 1);
+    entry->hash = hash_name(name, length);
+    entry->subdir = 0;
+    index->num_entries++;
+    return 1;
+}
+
+static int add_to_index(const char *filename)
+{
+    add_entry(data.index.building, filename);
+    return LIST_CONTINUE;
+}
+
+static dir_index *create_index(const char *dir)
+{
+    dir_index *index = calloc(1, sizeof(dir_index));
+    if (!index) {
+        return 0;
+    }
+    data.index.building = index;
+    int result = platform_file_manager_list_directory_contents(dir, TYPE_ANY, 0, add_to_index);
+    data.index.building = 0;
+    if (result == LIST_ERROR || !rebuild_buckets(index)) {
+        free_index(index);
+        return 0;
+    }
+    return index;
+}
+
+static dir_index *get_root_index(void)
+{
+    if (data.index.root_is_stale) {
+        free_index(data.index.root);
+        data.index.root = 0;
+        data.index.root_is_stale = 0;
+    }
+    if (!data.index.root) {
+        data.index.root = create_index(0);
+    }
+    return data.index.root;
+}
+
+static int find_in_dir_index(const char *filepath, char *corrected, size_t max_length)
+{
+    dir_index *index = get_root_index();
+    size_t corrected_length = 0;
+    const char *component = filepath;
+    while (*component) {
+        const char *end = component;
+        while (*end && *end != '/' && *end != '\\') {
+            end++;
+        }
+        size_t length = end - component;
+        const char *next = *end ? end + 1 : end;
+        if (length == 0 || (length == 1 && *component == '.')) {
+            // Empty parts, like in a double backslash, and references to the current dir
+            component = next;
+            continue;
+        }
+        if (!index) {
+            return INDEX_UNAVAILABLE;
+        }
+        dir_index_entry *entry = find_in_index(index, component, length);
+        if (!entry) {
+            return INDEX_NOT_FOUND;
+        }
+        size_t name_length = strlen(entry->name);
+        if (corrected_length + name_length + 2 > max_length) {
+            return INDEX_UNAVAILABLE;
+        }
+        if (corrected_length) {
+            corrected[corrected_length++] = '/';
+        }
+        memcpy(&corrected[corrected_length], entry->name, name_length + 1);
+        corrected_length += name_length;
+        if (*next) {
+            if (!entry->subdir) {
+                entry->subdir = create_index(corrected);
+            }
+            index = entry->subdir;
+        }
+        component = next;
+    }
+    return corrected_length ? INDEX_FOUND : INDEX_NOT_FOUND;
+}
+
+void dir_index_add_file(const char *filepath)
+{
+    if (!data.index.root || data.index.root_is_stale) {
+        return;
+    }
+    if (strchr(filepath, '/') || strchr(filepath, '\\')) {
+        // Files in subdirectories are rare: rebuild the index instead of finding the subdirectory to update
+        data.index.root_is_stale = 1;
+        return;
+    }
+    size_t length = strlen(filepath);
+    if (find_in_index(data.index.root, filepath, length)) {
+        return;
+    }
+    if (!add_entry(data.index.root, filepath) || !rebuild_buckets(data.index.root)) {
+        data.index.root_is_stale = 1;
+    }
+}
+
+void dir_index_remove_file(const char *filepath)
+{
+    // Removing from the open addressing table is not worth it: removals are rare
+    data.index.root_is_stale = 1;
+}
+
+void dir_index_reset(void)
+{
+    free_index(data.index.root);
+    data.index.root = 0;
+    data.index.root_is_stale = 0;
+}
+
 static int compare_case(const char *filename)
 {
     if (platform_file_manager_compare_filename(filename, data.cased_filename) == 0) {
@@ -109,6 +359,15 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
     static char corrected_filename[2 * FILE_NAME_MAX];
     corrected_filename[2 * FILE_NAME_MAX - 1] = 0;
 
+    if (platform_file_manager_should_case_correct_file()) {
+        char path[2 * FILE_NAME_MAX];
+        snprintf(path, 2 * FILE_NAME_MAX, "%s%s%s", dir ? dir : "", dir ? "/" : "", filepath);
+        int result = find_in_dir_index(path, corrected_filename, 2 * FILE_NAME_MAX);
+        if (result != INDEX_UNAVAILABLE) {
+            return result == INDEX_FOUND ? corrected_filename : 0;
+        }
+    }
+
     size_t dir_len = 0;
     if (dir) {
         dir_len = strlen(dir) + 1;
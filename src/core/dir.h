@@ -34,11 +34,29 @@ const dir_listing *dir_find_files_with_extension(const char *extension);
 const dir_listing *dir_find_all_subdirectories(void);
 
 /**
- * Get the case sensitive and localized filename of the file
+ * Get the case sensitive and localized filename of the file.
+ * Directory contents are indexed on first use, so repeated lookups do not touch the filesystem.
  * @param filepath File path to match to a case-sensitive file on the filesystem
  * @param localizable Whether the file may, must or must not be localized
  * @return Corrected file, or NULL if the file was not found
  */
 const char *dir_get_file(const char *filepath, int localizable);
 
+/**
+ * Adds a newly created file to the lookup index used by dir_get_file
+ * @param filepath File that was created
+ */
+void dir_index_add_file(const char *filepath);
+
+/**
+ * Removes a deleted file from the lookup index used by dir_get_file
+ * @param filepath File that was removed
+ */
+void dir_index_remove_file(const char *filepath);
+
+/**
+ * Clears the lookup index, to be called when the base directory changes
+ */
+void dir_index_reset(void);
+
 #endif // CORE_DIR_H
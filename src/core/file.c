@@ -5,10 +5,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 FILE *file_open(const char *filename, const char *mode)
 {
-    return platform_file_manager_open_file(filename, mode);
+    FILE *fp = platform_file_manager_open_file(filename, mode);
+    if (fp && (strchr(mode, 'w') || strchr(mode, 'a'))) {
+        dir_index_add_file(filename);
+    }
+    return fp;
 }
 
 int file_close(FILE *stream)
@@ -16,6 +21,21 @@ int file_close(FILE *stream)
     return platform_file_manager_close_file(stream);
 }
 
+const void *file_map(FILE *stream, size_t *size)
+{
+    return platform_file_manager_map_file(stream, size);
+}
+
+void file_unmap(const void *data, size_t size)
+{
+    platform_file_manager_unmap_file(data, size);
+}
+
+int file_get_stamp(FILE *stream, int64_t *size, int64_t *modified)
+{
+    return platform_file_manager_get_file_stamp(stream, size, modified);
+}
+
 int file_has_extension(const char *filename, const char *extension)
 {
     if (!extension || !*extension) {
@@ -82,5 +102,6 @@ int file_exists(const char *filename, int localizable)
 
 int file_remove(const char *filename)
 {
+    dir_index_remove_file(filename);
     return platform_file_manager_remove_file(filename);
 }
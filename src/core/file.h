@@ -33,6 +33,30 @@ FILE *file_open(const char *filename, const char *mode);
  */
 int file_close(FILE *stream);
 
+/**
+ * Maps an opened file into memory for reading, if the platform supports it
+ * @param stream File to map, may be closed after mapping
+ * @param[out] size Size of the mapping
+ * @return Read-only file contents, or NULL if the file cannot be mapped
+ */
+const void *file_map(FILE *stream, size_t *size);
+
+/**
+ * Releases a mapping created with file_map
+ * @param data Mapped contents
+ * @param size Size of the mapping
+ */
+void file_unmap(const void *data, size_t size);
+
+/**
+ * Gets the size and last modification time of an opened file
+ * @param stream File to check
+ * @param[out] size Size of the file in bytes
+ * @param[out] modified Last modification time
+ * @return boolean true if the information is available, false otherwise
+ */
+int file_get_stamp(FILE *stream, int64_t *size, int64_t *modified);
+
 /**
  * Checks whether the file has the given extension
  * @param filename Filename to check
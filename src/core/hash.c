@@ -0,0 +1,95 @@
+#include "core/hash.h"
+
+#include <string.h>
+
+#define PRIME64_1 0x9E3779B185EBCA87ULL
+#define PRIME64_2 0xC2B2AE3D27D4EB4FULL
+#define PRIME64_3 0x165667B19E3779F9ULL
+#define PRIME64_4 0x85EBCA77C2B2AE63ULL
+#define PRIME64_5 0x27D4EB2F165667C5ULL
+
+static uint64_t rotate_left(uint64_t value, int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint64_t read_u64(const uint8_t *data)
+{
+    uint64_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint32_t read_u32(const uint8_t *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+static uint64_t round_value(uint64_t accumulator, uint64_t input)
+{
+    accumulator += input * PRIME64_2;
+    accumulator = rotate_left(accumulator, 31);
+    return accumulator * PRIME64_1;
+}
+
+static uint64_t merge_round(uint64_t accumulator, uint64_t value)
+{
+    accumulator ^= round_value(0, value);
+    return accumulator * PRIME64_1 + PRIME64_4;
+}
+
+uint64_t hash_xxh64(const void *data, size_t size, uint64_t seed)
+{
+    const uint8_t *p = (const uint8_t *) data;
+    const uint8_t *end = p + size;
+    uint64_t hash;
+
+    if (size >= 32) {
+        // Four independent lanes, so the multiplications of consecutive words can overlap
+        const uint8_t *limit = end - 32;
+        uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
+        uint64_t v2 = seed + PRIME64_2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME64_1;
+        do {
+            v1 = round_value(v1, read_u64(p));
+            v2 = round_value(v2, read_u64(p + 8));
+            v3 = round_value(v3, read_u64(p + 16));
+            v4 = round_value(v4, read_u64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        hash = rotate_left(v1, 1) + rotate_left(v2, 7) + rotate_left(v3, 12) + rotate_left(v4, 18);
+        hash = merge_round(hash, v1);
+        hash = merge_round(hash, v2);
+        hash = merge_round(hash, v3);
+        hash = merge_round(hash, v4);
+    } else {
+        hash = seed + PRIME64_5;
+    }
+    hash += (uint64_t) size;
+
+    while (p + 8 <= end) {
+        hash ^= round_value(0, read_u64(p));
+        hash = rotate_left(hash, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        hash ^= (uint64_t) read_u32(p) * PRIME64_1;
+        hash = rotate_left(hash, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        hash ^= (*p) * PRIME64_5;
+        hash = rotate_left(hash, 11) * PRIME64_1;
+        p++;
+    }
+
+    hash ^= hash >> 33;
+    hash *= PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -0,0 +1,21 @@
+#ifndef CORE_HASH_H
+#define CORE_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file
+ * Hashing of memory blocks.
+ */
+
+/**
+ * Calculates the 64-bit xxHash (XXH64) of a block of memory
+ * @param data Data to hash
+ * @param size Size of the data in bytes
+ * @param seed Seed, pass the hash of a previous block to combine several blocks
+ * @return Hash of the data
+ */
+uint64_t hash_xxh64(const void *data, size_t size, uint64_t seed);
+
+#endif // CORE_HASH_H
@@ -77,7 +77,17 @@ static const char *ini_keys[] = {
     "resize_to_1024",
     "save_screenshot",
     "save_city_screenshot",
-    "clone_building"
+    "clone_building",
+    "quickload_1",
+    "quickload_2",
+    "quickload_3",
+    "quickload_4",
+    "quicksave_1",
+    "quicksave_2",
+    "quicksave_3",
+    "quicksave_4",
+    "toggle_performance_hud",
+    "save_performance_trace"
 };
 
 static struct {
@@ -169,6 +179,14 @@ static void init_defaults(void)
     set_mapping(KEY_TYPE_F2, KEY_MOD_ALT, HOTKEY_SET_BOOKMARK_2);
     set_mapping(KEY_TYPE_F3, KEY_MOD_ALT, HOTKEY_SET_BOOKMARK_3);
     set_mapping(KEY_TYPE_F4, KEY_MOD_ALT, HOTKEY_SET_BOOKMARK_4);
+    set_mapping(KEY_TYPE_F1, KEY_MOD_SHIFT, HOTKEY_QUICKLOAD_1);
+    set_mapping(KEY_TYPE_F2, KEY_MOD_SHIFT, HOTKEY_QUICKLOAD_2);
+    set_mapping(KEY_TYPE_F3, KEY_MOD_SHIFT, HOTKEY_QUICKLOAD_3);
+    set_mapping(KEY_TYPE_F4, KEY_MOD_SHIFT, HOTKEY_QUICKLOAD_4);
+    set_mapping(KEY_TYPE_F1, KEY_MOD_CTRL | KEY_MOD_SHIFT, HOTKEY_QUICKSAVE_1);
+    set_mapping(KEY_TYPE_F2, KEY_MOD_CTRL | KEY_MOD_SHIFT, HOTKEY_QUICKSAVE_2);
+    set_mapping(KEY_TYPE_F3, KEY_MOD_CTRL | KEY_MOD_SHIFT, HOTKEY_QUICKSAVE_3);
+    set_mapping(KEY_TYPE_F4, KEY_MOD_CTRL | KEY_MOD_SHIFT, HOTKEY_QUICKSAVE_4);
     set_mapping(KEY_TYPE_F5, KEY_MOD_NONE, HOTKEY_CENTER_WINDOW);
     set_mapping(KEY_TYPE_F6, KEY_MOD_NONE, HOTKEY_TOGGLE_FULLSCREEN);
     set_mapping(KEY_TYPE_ENTER, KEY_MOD_ALT, HOTKEY_TOGGLE_FULLSCREEN);
@@ -178,6 +196,8 @@ static void init_defaults(void)
     set_mapping(KEY_TYPE_F12, KEY_MOD_NONE, HOTKEY_SAVE_SCREENSHOT);
     set_mapping(KEY_TYPE_F12, KEY_MOD_ALT, HOTKEY_SAVE_SCREENSHOT); // mac specific
     set_mapping(KEY_TYPE_F12, KEY_MOD_CTRL, HOTKEY_SAVE_CITY_SCREENSHOT);
+    set_mapping(KEY_TYPE_F11, KEY_MOD_NONE, HOTKEY_TOGGLE_PERFORMANCE_HUD);
+    set_mapping(KEY_TYPE_F11, KEY_MOD_CTRL, HOTKEY_SAVE_PERFORMANCE_TRACE);
 }
 
 const hotkey_mapping *hotkey_for_action(hotkey_action action, int index)
@@ -67,6 +67,16 @@ typedef enum {
     HOTKEY_SAVE_SCREENSHOT,
     HOTKEY_SAVE_CITY_SCREENSHOT,
     HOTKEY_BUILD_CLONE,
+    HOTKEY_QUICKLOAD_1,
+    HOTKEY_QUICKLOAD_2,
+    HOTKEY_QUICKLOAD_3,
+    HOTKEY_QUICKLOAD_4,
+    HOTKEY_QUICKSAVE_1,
+    HOTKEY_QUICKSAVE_2,
+    HOTKEY_QUICKSAVE_3,
+    HOTKEY_QUICKSAVE_4,
+    HOTKEY_TOGGLE_PERFORMANCE_HUD,
+    HOTKEY_SAVE_PERFORMANCE_TRACE,
     HOTKEY_MAX_ITEMS
 } hotkey_action;
 
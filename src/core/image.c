@@ -4,6 +4,7 @@
 #include "core/file.h"
 #include "core/io.h"
 #include "core/log.h"
+#include "game/trace.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -292,12 +293,8 @@ static void load_empire(void)
     convert_uncompressed(&buf, size, data.empire_data);
 }
 
-int image_load_climate(int climate_id, int is_editor, int force_reload)
+static int load_climate(int climate_id, int is_editor)
 {
-    if (climate_id == data.current_climate && is_editor == data.is_editor && !force_reload) {
-        return 1;
-    }
-
     const char *filename_bmp = is_editor ? EDITOR_GRAPHICS_555[climate_id] : MAIN_GRAPHICS_555[climate_id];
     const char *filename_idx = is_editor ? EDITOR_GRAPHICS_SG2[climate_id] : MAIN_GRAPHICS_SG2[climate_id];
 
@@ -324,6 +321,17 @@ int image_load_climate(int climate_id, int is_editor, int force_reload)
     return 1;
 }
 
+int image_load_climate(int climate_id, int is_editor, int force_reload)
+{
+    if (climate_id == data.current_climate && is_editor == data.is_editor && !force_reload) {
+        return 1;
+    }
+    uint64_t start = trace_begin();
+    int result = load_climate(climate_id, is_editor);
+    trace_end("image_load_climate", start);
+    return result;
+}
+
 static void free_font_memory(void)
 {
     free(data.font);
@@ -644,7 +652,7 @@ static int load_japanese_fonts(void)
     return 1;
 }
 
-int image_load_fonts(encoding_type encoding)
+static int load_fonts(encoding_type encoding)
 {
     if (encoding == ENCODING_CYRILLIC) {
         return load_external_fonts(CYRILLIC_FONT_BASE_OFFSET);
@@ -664,7 +672,15 @@ int image_load_fonts(encoding_type encoding)
     }
 }
 
-int image_load_enemy(int enemy_id)
+int image_load_fonts(encoding_type encoding)
+{
+    uint64_t start = trace_begin();
+    int result = load_fonts(encoding);
+    trace_end("image_load_fonts", start);
+    return result;
+}
+
+static int load_enemy(int enemy_id)
 {
     const char *filename_bmp = ENEMY_GRAPHICS_555[enemy_id];
     const char *filename_idx = ENEMY_GRAPHICS_SG2[enemy_id];
@@ -687,6 +703,14 @@ int image_load_enemy(int enemy_id)
     return 1;
 }
 
+int image_load_enemy(int enemy_id)
+{
+    uint64_t start = trace_begin();
+    int result = load_enemy(enemy_id);
+    trace_end("image_load_enemy", start);
+    return result;
+}
+
 static const color_t *load_external_data(int image_id)
 {
     image *img = &data.main[image_id];
@@ -0,0 +1,121 @@
+#include "parallel.h"
+
+#include "core/thread.h"
+
+#include <string.h>
+
+#define MAX_WORKERS 7
+
+static struct {
+    int initialized;
+    int num_workers;
+    thread *workers[MAX_WORKERS];
+    thread_semaphore *start;
+    thread_semaphore *done;
+    // The fields below are shared with the workers and protected by the mutex
+    thread_mutex *mutex;
+    void (*function)(void *data, int part);
+    void *function_data;
+    int num_parts;
+    int next_part;
+    int stop_requested;
+} data;
+
+static int run_next_part(void)
+{
+    thread_mutex_lock(data.mutex);
+    if (data.next_part >= data.num_parts) {
+        thread_mutex_unlock(data.mutex);
+        return 0;
+    }
+    int part = data.next_part++;
+    thread_mutex_unlock(data.mutex);
+
+    data.function(data.function_data, part);
+    return 1;
+}
+
+static int run_worker(void *unused)
+{
+    while (1) {
+        thread_semaphore_wait(data.start);
+        if (data.stop_requested) {
+            break;
+        }
+        while (run_next_part()) {
+            // keep going
+        }
+        thread_semaphore_post(data.done);
+    }
+    return 0;
+}
+
+static void init_workers(void)
+{
+    data.initialized = 1;
+    int num_workers = thread_get_cpu_count() - 1;
+    if (num_workers <= 0) {
+        return;
+    }
+    if (num_workers > MAX_WORKERS) {
+        num_workers = MAX_WORKERS;
+    }
+    data.mutex = thread_mutex_create();
+    data.start = thread_semaphore_create(0);
+    data.done = thread_semaphore_create(0);
+    if (!data.mutex || !data.start || !data.done) {
+        parallel_shutdown();
+        data.initialized = 1;
+        return;
+    }
+    while (data.num_workers < num_workers) {
+        thread *worker = thread_create(run_worker, 0, "parallel");
+        if (!worker) {
+            break;
+        }
+        data.workers[data.num_workers++] = worker;
+    }
+}
+
+void parallel_run(void (*function)(void *data, int part), void *function_data, int num_parts)
+{
+    if (!data.initialized) {
+        init_workers();
+    }
+    if (!data.num_workers || num_parts <= 1) {
+        for (int i = 0; i < num_parts; i++) {
+            function(function_data, i);
+        }
+        return;
+    }
+    // Workers are idle here, so the job can be set up without locking
+    data.function = function;
+    data.function_data = function_data;
+    data.num_parts = num_parts;
+    data.next_part = 0;
+    int num_workers = data.num_workers < num_parts - 1 ? data.num_workers : num_parts - 1;
+    for (int i = 0; i < num_workers; i++) {
+        thread_semaphore_post(data.start);
+    }
+    while (run_next_part()) {
+        // keep going
+    }
+    for (int i = 0; i < num_workers; i++) {
+        thread_semaphore_wait(data.done);
+    }
+}
+
+void parallel_shutdown(void)
+{
+    data.stop_requested = 1;
+    for (int i = 0; i < data.num_workers; i++) {
+        thread_semaphore_post(data.start);
+    }
+    for (int i = 0; i < data.num_workers; i++) {
+        thread_wait(data.workers[i]);
+    }
+    thread_semaphore_destroy(data.start);
+    thread_semaphore_destroy(data.done);
+    thread_mutex_destroy(data.mutex);
+    memset(&data, 0, sizeof(data));
+}
@@ -0,0 +1,24 @@
+#ifndef CORE_PARALLEL_H
+#define CORE_PARALLEL_H
+
+/**
+ * @file
+ * Runs independent parts of a calculation at the same time on background threads.
+ * When the platform has no threads, all parts run on the calling thread.
+ */
+
+/**
+ * Runs a function for every part and waits until all parts are done.
+ * The parts may run in any order, so they must not write to data that another part reads or writes.
+ * @param function Function to run, gets the data and the number of the part
+ * @param data Data for the function
+ * @param num_parts Number of parts
+ */
+void parallel_run(void (*function)(void *data, int part), void *data, int num_parts);
+
+/**
+ * Stops the background threads
+ */
+void parallel_shutdown(void);
+
+#endif // CORE_PARALLEL_H
@@ -1,5 +1,7 @@
 #include "core/random.h"
 
+#include "core/hash.h"
+
 #include <string.h>
 
 #define MAX_RANDOM 100
@@ -85,3 +87,8 @@ void random_save_state(buffer *buf)
     buffer_write_u32(buf, data.iv1);
     buffer_write_u32(buf, data.iv2);
 }
+
+uint64_t random_hash_state(void)
+{
+    return hash_xxh64(&data, sizeof(data), 0);
+}
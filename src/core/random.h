@@ -62,4 +62,10 @@ void random_save_state(buffer *buf);
  */
 void random_load_state(buffer *buf);
 
+/**
+ * Hashes the state of the generator, to check that two runs are the same
+ * @return Hash of the state
+ */
+uint64_t random_hash_state(void);
+
 #endif // CORE_RANDOM_H
@@ -0,0 +1,91 @@
+#ifndef CORE_THREAD_H
+#define CORE_THREAD_H
+
+/**
+ * @file
+ * Background threads, implemented by the platform.
+ * Threads are optional: when a platform cannot create them, the caller should do the work itself.
+ */
+
+typedef struct thread thread;
+typedef struct thread_mutex thread_mutex;
+typedef struct thread_semaphore thread_semaphore;
+
+/**
+ * Starts a function on a new thread
+ * @param function Function to run
+ * @param data Argument for the function
+ * @param name Name of the thread, for debugging
+ * @return Thread handle, or 0 if no thread could be created
+ */
+thread *thread_create(int (*function)(void *), void *data, const char *name);
+
+/**
+ * Gets the number of processor cores
+ * @return Number of cores, 1 if the platform does not support threads
+ */
+int thread_get_cpu_count(void);
+
+/**
+ * Gets an identifier for the calling thread
+ * @return Thread id, 0 if the platform does not support threads
+ */
+unsigned long thread_current_id(void);
+
+/**
+ * Waits for a thread to finish and releases it
+ * @param t Thread to wait for
+ * @return Return value of the thread function
+ */
+int thread_wait(thread *t);
+
+/**
+ * Creates a mutex
+ * @return Mutex, or 0 if the platform does not support threads
+ */
+thread_mutex *thread_mutex_create(void);
+
+/**
+ * Locks the mutex, does nothing when the mutex is 0
+ * @param mutex Mutex to lock
+ */
+void thread_mutex_lock(thread_mutex *mutex);
+
+/**
+ * Unlocks the mutex, does nothing when the mutex is 0
+ * @param mutex Mutex to unlock
+ */
+void thread_mutex_unlock(thread_mutex *mutex);
+
+/**
+ * Destroys the mutex
+ * @param mutex Mutex to destroy
+ */
+void thread_mutex_destroy(thread_mutex *mutex);
+
+/**
+ * Creates a semaphore
+ * @param value Initial value of the semaphore
+ * @return Semaphore, or 0 if the platform does not support threads
+ */
+thread_semaphore *thread_semaphore_create(int value);
+
+/**
+ * Increments the semaphore, waking up a thread that waits for it
+ * @param semaphore Semaphore to increment
+ */
+void thread_semaphore_post(thread_semaphore *semaphore);
+
+/**
+ * Waits until the semaphore is positive and decrements it
+ * @param semaphore Semaphore to wait for
+ */
+void thread_semaphore_wait(thread_semaphore *semaphore);
+
+/**
+ * Destroys the semaphore
+ * @param semaphore Semaphore to destroy
+ */
+void thread_semaphore_destroy(thread_semaphore *semaphore);
+
+#endif // CORE_THREAD_H
@@ -8,8 +8,11 @@
 #include "figure/sound.h"
 #include "game/difficulty.h"
 #include "map/figure.h"
+#include "map/grid.h"
 #include "sound/effect.h"
 
+#include <stdlib.h>
+
 static int is_attacking_native(const figure *f)
 {
     return f->type == FIGURE_INDIGENOUS_NATIVE && f->action_state == FIGURE_ACTION_159_NATIVE_ATTACKING;
@@ -148,110 +151,154 @@ void figure_combat_handle_attack(figure *f)
     }
 }
 
-int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
+static struct {
+    int x;
+    int y;
+    int max_distance;
+    int min_distance;
+    int min_figure_id;
+    int attack_citizens;
+    int num_candidates;
+    int candidates[MAX_FIGURES];
+} search;
+
+static void start_search(int x, int y, int max_distance)
 {
-    int min_figure_id = 0;
-    int min_distance = 10000;
-    for (int i = 1; i < MAX_FIGURES; i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
-            int distance = calc_maximum_distance(x, y, f->x, f->y);
-            if (distance <= max_distance) {
-                if (f->targeted_by_figure_id) {
-                    distance *= 2; // penalty
-                }
-                if (distance < min_distance) {
-                    min_distance = distance;
-                    min_figure_id = i;
-                }
-            }
+    search.x = x;
+    search.y = y;
+    search.max_distance = max_distance;
+    search.min_distance = 10000;
+    search.min_figure_id = 0;
+    search.num_candidates = 0;
+}
+
+static void consider_target(const figure *f, int distance)
+{
+    // Same result as scanning all figures in order of id, keeping the first one with the lowest distance
+    if (distance < search.min_distance || (distance == search.min_distance && f->id < search.min_figure_id)) {
+        search.min_distance = distance;
+        search.min_figure_id = f->id;
+    }
+}
+
+static int compare_figure_id(const void *a, const void *b)
+{
+    return *(const int *) a - *(const int *) b;
+}
+
+static void sort_candidates(void)
+{
+    qsort(search.candidates, search.num_candidates, sizeof(int), compare_figure_id);
+}
+
+static int is_soldier_target(const figure *f)
+{
+    return figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f);
+}
+
+static void find_soldier_target(figure *f)
+{
+    if (figure_is_dead(f) || !is_soldier_target(f)) {
+        return;
+    }
+    int distance = calc_maximum_distance(search.x, search.y, f->x, f->y);
+    if (distance <= search.max_distance) {
+        if (f->targeted_by_figure_id) {
+            distance *= 2; // penalty
         }
+        consider_target(f, distance);
     }
-    if (min_figure_id) {
-        return min_figure_id;
+}
+
+int figure_combat_get_target_for_soldier(int x, int y, int max_distance)
+{
+    start_search(x, y, max_distance);
+    map_figure_foreach_near(x, y, max_distance, find_soldier_target);
+    if (search.min_figure_id) {
+        return search.min_figure_id;
     }
     for (int i = 1; i < MAX_FIGURES; i++) {
         figure *f = figure_get(i);
         if (figure_is_dead(f)) {
             continue;
         }
-        if (figure_is_enemy(f) || f->type == FIGURE_RIOTER || is_attacking_native(f)) {
+        if (is_soldier_target(f)) {
             return i;
         }
     }
     return 0;
 }
 
+static void find_wolf_target(figure *f)
+{
+    if (figure_is_dead(f) || !f->type) {
+        return;
+    }
+    switch (f->type) {
+        case FIGURE_EXPLOSION:
+        case FIGURE_FORT_STANDARD:
+        case FIGURE_TRADE_SHIP:
+        case FIGURE_FISHING_BOAT:
+        case FIGURE_MAP_FLAG:
+        case FIGURE_FLOTSAM:
+        case FIGURE_SHIPWRECK:
+        case FIGURE_INDIGENOUS_NATIVE:
+        case FIGURE_TOWER_SENTRY:
+        case FIGURE_NATIVE_TRADER:
+        case FIGURE_ARROW:
+        case FIGURE_JAVELIN:
+        case FIGURE_BOLT:
+        case FIGURE_BALLISTA:
+        case FIGURE_CREATURE:
+            return;
+    }
+    if (figure_is_enemy(f) || figure_is_herd(f)) {
+        return;
+    }
+    if (figure_is_legion(f) && f->action_state == FIGURE_ACTION_80_SOLDIER_AT_REST) {
+        return;
+    }
+    int distance = calc_maximum_distance(search.x, search.y, f->x, f->y);
+    if (f->targeted_by_figure_id) {
+        distance *= 2;
+    }
+    // The closest figure is only a target when it is within range, so skipping others makes no difference
+    if (distance <= search.max_distance) {
+        consider_target(f, distance);
+    }
+}
+
 int figure_combat_get_target_for_wolf(int x, int y, int max_distance)
 {
-    int min_figure_id = 0;
-    int min_distance = 10000;
-    for (int i = 1; i < MAX_FIGURES; i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f) || !f->type) {
-            continue;
-        }
-        switch (f->type) {
-            case FIGURE_EXPLOSION:
-            case FIGURE_FORT_STANDARD:
-            case FIGURE_TRADE_SHIP:
-            case FIGURE_FISHING_BOAT:
-            case FIGURE_MAP_FLAG:
-            case FIGURE_FLOTSAM:
-            case FIGURE_SHIPWRECK:
-            case FIGURE_INDIGENOUS_NATIVE:
-            case FIGURE_TOWER_SENTRY:
-            case FIGURE_NATIVE_TRADER:
-            case FIGURE_ARROW:
-            case FIGURE_JAVELIN:
-            case FIGURE_BOLT:
-            case FIGURE_BALLISTA:
-            case FIGURE_CREATURE:
-                continue;
-        }
-        if (figure_is_enemy(f) || figure_is_herd(f)) {
-            continue;
-        }
-        if (figure_is_legion(f) && f->action_state == FIGURE_ACTION_80_SOLDIER_AT_REST) {
-            continue;
-        }
-        int distance = calc_maximum_distance(x, y, f->x, f->y);
-        if (f->targeted_by_figure_id) {
-            distance *= 2;
-        }
-        if (distance < min_distance) {
-            min_distance = distance;
-            min_figure_id = i;
-        }
+    start_search(x, y, max_distance);
+    map_figure_foreach_near(x, y, max_distance, find_wolf_target);
+    return search.min_figure_id;
+}
+
+static void find_enemy_target(figure *f)
+{
+    if (figure_is_dead(f) || f->targeted_by_figure_id || !figure_is_legion(f)) {
+        return;
     }
-    if (min_distance <= max_distance && min_figure_id) {
-        return min_figure_id;
+    int distance = calc_maximum_distance(search.x, search.y, f->x, f->y);
+    if (distance <= search.max_distance) {
+        consider_target(f, distance);
     }
-    return 0;
 }
 
 int figure_combat_get_target_for_enemy(int x, int y)
 {
-    int min_figure_id = 0;
-    int min_distance = 10000;
-    for (int i = 1; i < MAX_FIGURES; i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (!f->targeted_by_figure_id && figure_is_legion(f)) {
-            int distance = calc_maximum_distance(x, y, f->x, f->y);
-            if (distance < min_distance) {
-                min_distance = distance;
-                min_figure_id = i;
-            }
+    // Search in growing areas: the closest soldier within an area is the closest soldier overall
+    for (int max_distance = 8; ; max_distance *= 2) {
+        int is_whole_map = max_distance >= GRID_SIZE;
+        start_search(x, y, is_whole_map ? 10000 : max_distance);
+        map_figure_foreach_near(x, y, search.max_distance, find_enemy_target);
+        if (search.min_figure_id || is_whole_map) {
+            break;
         }
     }
-    if (min_figure_id) {
-        return min_figure_id;
+    if (search.min_figure_id) {
+        return search.min_figure_id;
     }
     // no 'free' soldier found, take first one
     for (int i = 1; i < MAX_FIGURES; i++) {
@@ -266,24 +313,36 @@ int figure_combat_get_target_for_enemy(int x, int y)
     return 0;
 }
 
+static void find_soldier_missile_candidate(figure *f)
+{
+    if (figure_is_dead(f)) {
+        return;
+    }
+    if (figure_is_enemy(f) || figure_is_herd(f) || is_attacking_native(f)) {
+        if (calc_maximum_distance(search.x, search.y, f->x, f->y) < search.max_distance) {
+            search.candidates[search.num_candidates++] = f->id;
+        }
+    }
+}
+
 int figure_combat_get_missile_target_for_soldier(figure *shooter, int max_distance, map_point *tile)
 {
     int x = shooter->x;
     int y = shooter->y;
 
+    start_search(x, y, max_distance);
+    map_figure_foreach_near(x, y, max_distance, find_soldier_missile_candidate);
+    // Checking the line of fire has side effects on the scratch figure, so keep the original order
+    sort_candidates();
+
     int min_distance = max_distance;
     figure *min_figure = 0;
-    for (int i = 1; i < MAX_FIGURES; i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f)) {
-            continue;
-        }
-        if (figure_is_enemy(f) || figure_is_herd(f) || is_attacking_native(f)) {
-            int distance = calc_maximum_distance(x, y, f->x, f->y);
-            if (distance < min_distance && figure_movement_can_launch_cross_country_missile(x, y, f->x, f->y)) {
-                min_distance = distance;
-                min_figure = f;
-            }
+    for (int i = 0; i < search.num_candidates; i++) {
+        figure *f = figure_get(search.candidates[i]);
+        int distance = calc_maximum_distance(x, y, f->x, f->y);
+        if (distance < min_distance && figure_movement_can_launch_cross_country_missile(x, y, f->x, f->y)) {
+            min_distance = distance;
+            min_figure = f;
         }
     }
     if (min_figure) {
@@ -293,47 +352,64 @@ int figure_combat_get_missile_target_for_soldier(figure *shooter, int max_distan
     return 0;
 }
 
+static int get_enemy_missile_distance(const figure *f)
+{
+    if (figure_is_dead(f) || !f->type) {
+        return -1;
+    }
+    switch (f->type) {
+        case FIGURE_EXPLOSION:
+        case FIGURE_FORT_STANDARD:
+        case FIGURE_MAP_FLAG:
+        case FIGURE_FLOTSAM:
+        case FIGURE_INDIGENOUS_NATIVE:
+        case FIGURE_NATIVE_TRADER:
+        case FIGURE_ARROW:
+        case FIGURE_JAVELIN:
+        case FIGURE_BOLT:
+        case FIGURE_BALLISTA:
+        case FIGURE_CREATURE:
+        case FIGURE_FISH_GULLS:
+        case FIGURE_SHIPWRECK:
+        case FIGURE_SHEEP:
+        case FIGURE_WOLF:
+        case FIGURE_ZEBRA:
+        case FIGURE_SPEAR:
+            return -1;
+    }
+    if (figure_is_legion(f)) {
+        return calc_maximum_distance(search.x, search.y, f->x, f->y);
+    } else if (search.attack_citizens && f->is_friendly) {
+        return calc_maximum_distance(search.x, search.y, f->x, f->y) + 5;
+    }
+    return -1;
+}
+
+static void find_enemy_missile_candidate(figure *f)
+{
+    int distance = get_enemy_missile_distance(f);
+    if (distance >= 0 && distance < search.max_distance) {
+        search.candidates[search.num_candidates++] = f->id;
+    }
+}
+
 int figure_combat_get_missile_target_for_enemy(figure *enemy, int max_distance, int attack_citizens,
                                                map_point *tile)
 {
     int x = enemy->x;
     int y = enemy->y;
 
+    start_search(x, y, max_distance);
+    search.attack_citizens = attack_citizens;
+    map_figure_foreach_near(x, y, max_distance, find_enemy_missile_candidate);
+    // Checking the line of fire has side effects on the scratch figure, so keep the original order
+    sort_candidates();
+
     figure *min_figure = 0;
     int min_distance = max_distance;
-    for (int i = 1; i < MAX_FIGURES; i++) {
-        figure *f = figure_get(i);
-        if (figure_is_dead(f) || !f->type) {
-            continue;
-        }
-        switch (f->type) {
-            case FIGURE_EXPLOSION:
-            case FIGURE_FORT_STANDARD:
-            case FIGURE_MAP_FLAG:
-            case FIGURE_FLOTSAM:
-            case FIGURE_INDIGENOUS_NATIVE:
-            case FIGURE_NATIVE_TRADER:
-            case FIGURE_ARROW:
-            case FIGURE_JAVELIN:
-            case FIGURE_BOLT:
-            case FIGURE_BALLISTA:
-            case FIGURE_CREATURE:
-            case FIGURE_FISH_GULLS:
-            case FIGURE_SHIPWRECK:
-            case FIGURE_SHEEP:
-            case FIGURE_WOLF:
-            case FIGURE_ZEBRA:
-            case FIGURE_SPEAR:
-                continue;
-        }
-        int distance;
-        if (figure_is_legion(f)) {
-            distance = calc_maximum_distance(x, y, f->x, f->y);
-        } else if (attack_citizens && f->is_friendly) {
-            distance = calc_maximum_distance(x, y, f->x, f->y) + 5;
-        } else {
-            continue;
-        }
+    for (int i = 0; i < search.num_candidates; i++) {
+        figure *f = figure_get(search.candidates[i]);
+        int distance = get_enemy_missile_distance(f);
         if (distance < min_distance && figure_movement_can_launch_cross_country_missile(x, y, f->x, f->y)) {
             min_distance = distance;
             min_figure = f;
@@ -2,6 +2,7 @@
 
 #include "building/building.h"
 #include "city/emperor.h"
+#include "core/hash.h"
 #include "core/random.h"
 #include "empire/city.h"
 #include "figure/name.h"
@@ -361,3 +362,8 @@ void figure_load_state(buffer *list, buffer *seq)
         data.figures[i].id = i;
     }
 }
+
+uint64_t figure_hash_state(void)
+{
+    return hash_xxh64(&data, sizeof(data), 0);
+}
@@ -2,6 +2,7 @@
 
 #include "city/military.h"
 #include "core/calc.h"
+#include "core/hash.h"
 #include "figure/enemy_army.h"
 #include "figure/figure.h"
 #include "figure/formation_enemy.h"
@@ -748,3 +749,11 @@ void formations_load_state(buffer *buf, buffer *totals)
         f->invasion_sequence = buffer_read_i16(buf);
     }
 }
+
+uint64_t formations_hash_state(void)
+{
+    uint64_t hash = 0;
+    hash = hash_xxh64(formations, sizeof(formations), hash);
+    hash = hash_xxh64(&data, sizeof(data), hash);
+    return hash;
+}
@@ -180,4 +180,6 @@ void formation_update_all(int second_time);
 void formations_save_state(buffer *buf, buffer *totals);
 void formations_load_state(buffer *buf, buffer *totals);
 
+uint64_t formations_hash_state(void);
+
 #endif // FIGURE_FORMATION_H
@@ -1,8 +1,12 @@
 #include "route.h"
 
+#include "core/hash.h"
+#include "game/trace.h"
 #include "map/routing.h"
 #include "map/routing_path.h"
 
+#include <string.h>
+
 #define MAX_PATH_LENGTH 500
 #define MAX_ROUTES 600
 
@@ -11,6 +15,8 @@ static struct {
     uint8_t direction_paths[MAX_ROUTES][MAX_PATH_LENGTH];
 } data;
 
+static figure_route_statistics statistics;
+
 void figure_route_clear_all(void)
 {
     for (int i = 0; i < MAX_ROUTES; i++) {
@@ -49,10 +55,13 @@ void figure_route_add(figure *f)
     f->routing_path_id = 0;
     f->routing_path_current_tile = 0;
     f->routing_path_length = 0;
+    statistics.paths_requested++;
     int path_id = get_first_available();
     if (!path_id) {
+        statistics.pool_full++;
         return;
     }
+    uint64_t trace_start_time = trace_begin();
     int path_length;
     if (f->is_boat) {
         if (f->is_boat == 2) { // flotsam
@@ -121,10 +130,13 @@ void figure_route_add(figure *f)
             path_length = 0;
         }
     }
+    trace_end("figure_route_add", trace_start_time);
     if (path_length) {
         data.figure_ids[path_id] = f->id;
         f->routing_path_id = path_id;
         f->routing_path_length = path_length;
+        statistics.paths_found++;
+        statistics.total_path_length += path_length;
     }
 }
 
@@ -143,6 +155,32 @@ int figure_route_get_direction(int path_id, int index)
     return data.direction_paths[path_id][index];
 }
 
+const figure_route_statistics *figure_route_get_statistics(void)
+{
+    return &statistics;
+}
+
+void figure_route_reset_statistics(void)
+{
+    memset(&statistics, 0, sizeof(statistics));
+}
+
+int figure_route_get_used_paths(void)
+{
+    int used = 0;
+    for (int i = 1; i < MAX_ROUTES; i++) {
+        if (data.figure_ids[i]) {
+            used++;
+        }
+    }
+    return used;
+}
+
+int figure_route_get_max_paths(void)
+{
+    return MAX_ROUTES - 1;
+}
+
 void figure_route_save_state(buffer *figures, buffer *paths)
 {
     for (int i = 0; i < MAX_ROUTES; i++) {
@@ -158,3 +196,15 @@ void figure_route_load_state(buffer *figures, buffer *paths)
         buffer_read_raw(paths, data.direction_paths[i], MAX_PATH_LENGTH);
     }
 }
+
+uint64_t figure_route_hash_state(void)
+{
+    uint64_t hash = hash_xxh64(data.figure_ids, sizeof(data.figure_ids), 0);
+    // Free paths keep the directions of their previous figure, which are never read again
+    for (int i = 1; i < MAX_ROUTES; i++) {
+        if (data.figure_ids[i]) {
+            hash = hash_xxh64(data.direction_paths[i], MAX_PATH_LENGTH, hash);
+        }
+    }
+    return hash;
+}
@@ -4,6 +4,13 @@
 #include "core/buffer.h"
 #include "figure/figure.h"
 
+typedef struct {
+    uint64_t paths_requested;
+    uint64_t paths_found;
+    uint64_t total_path_length;
+    uint64_t pool_full; // requests dropped because every path slot was taken
+} figure_route_statistics;
+
 void figure_route_clear_all(void);
 
 void figure_route_clean(void);
@@ -14,8 +21,18 @@ void figure_route_remove(figure *f);
 
 int figure_route_get_direction(int path_id, int index);
 
+const figure_route_statistics *figure_route_get_statistics(void);
+
+void figure_route_reset_statistics(void);
+
+int figure_route_get_used_paths(void);
+
+int figure_route_get_max_paths(void);
+
 void figure_route_save_state(buffer *figures, buffer *paths);
 
 void figure_route_load_state(buffer *figures, buffer *paths);
 
+uint64_t figure_route_hash_state(void);
+
 #endif // FIGURE_ROUTE_H
@@ -17,7 +17,7 @@ static int provide_culture(int x, int y, void (*callback)(building *))
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
+            int building_id = map_building_house_at(grid_offset);
             if (building_id) {
                 building *b = building_get(building_id);
                 if (b->house_size && b->house_population > 0) {
@@ -38,7 +38,7 @@ static int provide_entertainment(int x, int y, int shows, void (*callback)(build
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
+            int building_id = map_building_house_at(grid_offset);
             if (building_id) {
                 building *b = building_get(building_id);
                 if (b->house_size && b->house_population > 0) {
@@ -284,7 +284,7 @@ static int provide_market_goods(int market_building_id, int x, int y)
     for (int yy = y_min; yy <= y_max; yy++) {
         for (int xx = x_min; xx <= x_max; xx++) {
             int grid_offset = map_grid_offset(xx, yy);
-            int building_id = map_building_at(grid_offset);
+            int building_id = map_building_house_at(grid_offset);
             if (building_id) {
                 building *b = building_get(building_id);
                 if (b->house_size && b->house_population > 0) {
@@ -1,6 +1,7 @@
 #include "docker.h"
 
 #include "building/building.h"
+#include "building/list.h"
 #include "building/storage.h"
 #include "building/warehouse.h"
 #include "city/buildings.h"
@@ -90,8 +91,10 @@ static int get_closest_warehouse_for_import(int x, int y, int city_id, int dista
     }
     int min_distance = 10000;
     int min_building_id = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE) {
             continue;
         }
@@ -121,7 +124,7 @@ static int get_closest_warehouse_for_import(int x, int y, int city_id, int dista
                 distance += distance_penalty;
                 if (distance < min_distance) {
                     min_distance = distance;
-                    min_building_id = i;
+                    min_building_id = b->id;
                 }
             }
         }
@@ -156,8 +159,10 @@ static int get_closest_warehouse_for_export(int x, int y, int city_id, int dista
     }
     int min_distance = 10000;
     int min_building_id = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE) {
             continue;
         }
@@ -181,7 +186,7 @@ static int get_closest_warehouse_for_export(int x, int y, int city_id, int dista
             distance += distance_penalty;
             if (distance < min_distance) {
                 min_distance = distance;
-                min_building_id = i;
+                min_building_id = b->id;
             }
         }
     }
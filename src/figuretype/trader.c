@@ -1,6 +1,7 @@
 #include "trader.h"
 
 #include "building/building.h"
+#include "building/list.h"
 #include "building/dock.h"
 #include "building/warehouse.h"
 #include "building/storage.h"
@@ -244,8 +245,10 @@ static int get_closest_warehouse(
     }
     int min_distance = 10000;
     building *min_building = 0;
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
+    const int *warehouses = building_list_storage_items(BUILDING_WAREHOUSE);
+    int num_warehouses = building_list_storage_size(BUILDING_WAREHOUSE);
+    for (int i = 0; i < num_warehouses; i++) {
+        building *b = building_get(warehouses[i]);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_WAREHOUSE) {
             continue;
         }
@@ -364,6 +364,33 @@ int game_file_write_saved_game(const char *filename)
     return game_file_io_write_saved_game(filename);
 }
 
+int game_file_write_saved_game_in_background(const char *filename)
+{
+    return game_file_io_write_saved_game_in_background(filename);
+}
+
+int game_file_write_delta_autosave(const char *base_filename, const char *delta_filename)
+{
+    return game_file_io_write_delta_autosave(base_filename, delta_filename);
+}
+
+int game_file_quicksave(int slot)
+{
+    return game_file_io_write_quicksave(slot);
+}
+
+int game_file_quickload(int slot)
+{
+    if (!game_file_io_read_quicksave(slot)) {
+        return 0;
+    }
+    initialize_saved_game();
+    building_storage_reset_building_ids();
+
+    sound_music_update(1);
+    return 1;
+}
+
 int game_file_delete_saved_game(const char *filename)
 {
     return game_file_io_delete_saved_game(filename);
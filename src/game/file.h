@@ -38,6 +38,37 @@ int game_file_load_saved_game(const char *filename);
  */
 int game_file_write_saved_game(const char *filename);
 
+/**
+ * Write saved game to disk, compressing and writing the file on a background thread
+ * @param filename File to save to
+ * @return Boolean true if saving was started, false on failure
+ */
+int game_file_write_saved_game_in_background(const char *filename);
+
+/**
+ * Write monthly autosave as a delta chain: a full base save followed by
+ * monthly records of the bytes that changed since the previous month.
+ * The chain is rebased automatically every year and after loading a game.
+ * @param base_filename Full saved game to use as base
+ * @param delta_filename Delta chain file to append to
+ * @return Boolean true on success, false on failure
+ */
+int game_file_write_delta_autosave(const char *base_filename, const char *delta_filename);
+
+/**
+ * Store the current game in an in-memory quicksave slot
+ * @param slot Slot to save to, 0 to MAX_QUICKSAVE_SLOTS - 1
+ * @return Boolean true on success, false on failure
+ */
+int game_file_quicksave(int slot);
+
+/**
+ * Restore the game from an in-memory quicksave slot
+ * @param slot Slot to load from, 0 to MAX_QUICKSAVE_SLOTS - 1
+ * @return Boolean true on success, false if the slot is empty
+ */
+int game_file_quickload(int slot);
+
 /**
  * Delete saved game
  * @param filename File to delete
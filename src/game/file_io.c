@@ -12,6 +12,7 @@
 #include "city/view.h"
 #include "core/dir.h"
 #include "core/random.h"
+#include "core/thread.h"
 #include "core/zip.h"
 #include "empire/city.h"
 #include "empire/empire.h"
@@ -22,7 +23,9 @@
 #include "figure/name.h"
 #include "figure/route.h"
 #include "figure/trader.h"
+#include "game/system.h"
 #include "game/time.h"
+#include "game/trace.h"
 #include "game/tutorial.h"
 #include "map/aqueduct.h"
 #include "map/bookmark.h"
@@ -49,17 +52,39 @@
 #include <string.h>
 
 #define COMPRESS_BUFFER_SIZE 600000
+#define MAX_SAVEGAME_PIECES 100
 #define UNCOMPRESSED 0x80000000
 
+// Offsets into the uncompressed city data piece
+#define CITY_DATA_TREASURY_OFFSET 18080
+#define CITY_DATA_POPULATION_OFFSET 18104
+
+#define DELTA_FILE_VERSION 1
+#define DELTA_REBASE_MONTHS 12
+// Equal stretches shorter than this are merged into the surrounding run,
+// as they would cost more in run headers than they save
+#define DELTA_MIN_RUN_GAP 8
+
 static const int SAVE_GAME_VERSION = 0x66;
 
 static char compress_buffer[COMPRESS_BUFFER_SIZE];
 
 static int savegame_version;
 
+static struct {
+    thread *worker;
+    FILE *fp;
+    uint8_t *data;
+    int num_pieces;
+    int piece_sizes[MAX_SAVEGAME_PIECES];
+    int piece_compressed[MAX_SAVEGAME_PIECES];
+} background_save;
+
 typedef struct {
     buffer buf;
+    int size;
     int compressed;
+    uint8_t *owned_data;
 } file_piece;
 
 typedef struct {
@@ -169,16 +194,30 @@ typedef struct {
 
 static struct {
     int num_pieces;
-    file_piece pieces[100];
+    file_piece pieces[MAX_SAVEGAME_PIECES];
     savegame_state state;
 } savegame_data = {0};
 
+static struct {
+    uint8_t *data;
+    int size;
+} quicksave_slots[MAX_QUICKSAVE_SLOTS];
+
+static struct {
+    int valid;
+    int months_since_base;
+    int size;
+    uint8_t *previous;
+    uint8_t *output;
+} delta_autosave;
+
 static void init_file_piece(file_piece *piece, int size, int compressed)
 {
+    piece->size = size;
     piece->compressed = compressed;
-    void *data = malloc(size);
-    memset(data, 0, size);
-    buffer_init(&piece->buf, data, size);
+    piece->owned_data = malloc(size);
+    memset(piece->owned_data, 0, size);
+    buffer_init(&piece->buf, piece->owned_data, size);
 }
 
 static buffer *create_scenario_piece(int size)
@@ -507,6 +546,7 @@ static void savegame_save_to_state(savegame_state *state)
 int game_file_io_read_scenario(const char *filename)
 {
     log_info("Loading scenario", filename, 0);
+    delta_autosave.valid = 0;
     init_scenario_data();
     FILE *fp = file_open(dir_get_file(filename, NOT_LOCALIZED), "rb");
     if (!fp) {
@@ -583,15 +623,15 @@ static int read_compressed_chunk(FILE *fp, void *buffer, int bytes_to_read)
     return 1;
 }
 
-static int write_compressed_chunk(FILE *fp, const void *buffer, int bytes_to_write)
+static int write_compressed_chunk(FILE *fp, const void *buffer, int bytes_to_write, void *output)
 {
     if (bytes_to_write > COMPRESS_BUFFER_SIZE) {
         return 0;
     }
     int output_size = COMPRESS_BUFFER_SIZE;
-    if (zip_compress(buffer, bytes_to_write, compress_buffer, &output_size)) {
+    if (zip_compress(buffer, bytes_to_write, output, &output_size)) {
         write_int32(fp, output_size);
-        fwrite(compress_buffer, 1, output_size, fp);
+        fwrite(output, 1, output_size, fp);
     } else {
         // unable to compress: write uncompressed
         write_int32(fp, UNCOMPRESSED);
@@ -623,16 +663,89 @@ static void savegame_write_to_file(FILE *fp)
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
         if (piece->compressed) {
-            write_compressed_chunk(fp, piece->buf.data, piece->buf.size);
+            write_compressed_chunk(fp, piece->buf.data, piece->buf.size, compress_buffer);
         } else {
             fwrite(piece->buf.data, 1, piece->buf.size, fp);
         }
     }
 }
 
+static int map_uncompressed_chunk(file_piece *piece, const uint8_t *data, size_t size, size_t *offset)
+{
+    if (*offset + piece->buf.size > size) {
+        memcpy(piece->buf.data, &data[*offset], size - *offset);
+        *offset = size;
+        return 0;
+    }
+    // Point the piece directly at the mapping, no need to copy anything
+    buffer_init(&piece->buf, (void *) &data[*offset], piece->buf.size);
+    *offset += piece->buf.size;
+    return 1;
+}
+
+static int map_compressed_chunk(file_piece *piece, const uint8_t *data, size_t size, size_t *offset)
+{
+    if (*offset + 4 > size) {
+        return 0;
+    }
+    buffer buf;
+    buffer_init(&buf, (void *) &data[*offset], 4);
+    int input_size = buffer_read_i32(&buf);
+    *offset += 4;
+    if ((unsigned int) input_size == UNCOMPRESSED) {
+        return map_uncompressed_chunk(piece, data, size, offset);
+    }
+    if (input_size < 0 || *offset + input_size > size) {
+        return 0;
+    }
+    int bytes_to_read = piece->buf.size;
+    int result = zip_decompress(&data[*offset], input_size, piece->buf.data, &bytes_to_read);
+    *offset += input_size;
+    return result;
+}
+
+static int savegame_read_from_mapping(const uint8_t *data, size_t size)
+{
+    size_t offset = 0;
+    char label[32];
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        uint64_t start = system_get_time_us();
+        int result;
+        if (piece->compressed) {
+            result = map_compressed_chunk(piece, data, size, &offset);
+        } else {
+            result = map_uncompressed_chunk(piece, data, size, &offset);
+        }
+        const char *method = piece->buf.data != piece->owned_data ? "mapped" :
+            piece->compressed ? "decompressed" : "copied";
+        snprintf(label, sizeof(label), "%d (%s)", i, method);
+        log_info("Load time in us for piece", label, (int) (system_get_time_us() - start));
+        // The last piece may be smaller than buf.size
+        if (!result && i != (savegame_data.num_pieces - 1)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void release_mapped_pieces(void)
+{
+    // Some save functions skip over bytes, so the loaded data has to survive for the next save
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        file_piece *piece = &savegame_data.pieces[i];
+        if (piece->buf.data != piece->owned_data) {
+            memcpy(piece->owned_data, piece->buf.data, piece->buf.size);
+            buffer_init(&piece->buf, piece->owned_data, piece->buf.size);
+        }
+    }
+}
+
 int game_file_io_read_saved_game(const char *filename, int offset)
 {
+    game_file_io_wait_for_background_save();
     init_savegame_data();
+    delta_autosave.valid = 0;
 
     log_info("Loading saved game", filename, 0);
     FILE *fp = file_open(dir_get_file(filename, NOT_LOCALIZED), "rb");
@@ -640,39 +753,411 @@ int game_file_io_read_saved_game(const char *filename, int offset)
         log_error("Unable to load game", 0, 0);
         return 0;
     }
-    if (offset) {
-        fseek(fp, offset, SEEK_SET);
+    uint64_t trace_start_time = trace_begin();
+    size_t mapped_size = 0;
+    const uint8_t *mapped = file_map(fp, &mapped_size);
+    int result;
+    if (mapped) {
+        result = (size_t) offset < mapped_size && savegame_read_from_mapping(&mapped[offset], mapped_size - offset);
+    } else {
+        if (offset) {
+            fseek(fp, offset, SEEK_SET);
+        }
+        result = savegame_read_from_file(fp);
     }
-    int result = savegame_read_from_file(fp);
     file_close(fp);
+    trace_end("savegame_read", trace_start_time);
+    if (result) {
+        TRACE_CALL(savegame_load_from_state(&savegame_data.state));
+    }
+    if (mapped) {
+        release_mapped_pieces();
+        file_unmap(mapped, mapped_size);
+    }
     if (!result) {
         log_error("Unable to load game", 0, 0);
         return 0;
     }
-    savegame_load_from_state(&savegame_data.state);
     return 1;
 }
 
+void game_file_io_init_saved_game_info(void)
+{
+    if (!savegame_data.num_pieces) {
+        init_savegame_data();
+    }
+}
+
+static int read_info_piece(FILE *fp, const file_piece *piece, uint8_t *data)
+{
+    int input_size = piece->size;
+    if (piece->compressed) {
+        input_size = read_int32(fp);
+        if ((unsigned int) input_size == UNCOMPRESSED) {
+            input_size = piece->size;
+        } else if (input_size <= 0 || input_size > COMPRESS_BUFFER_SIZE) {
+            return 0;
+        } else if (data) {
+            // Not using the shared compress buffer: this may run on a background thread
+            uint8_t *compressed = malloc(input_size);
+            int output_size = piece->size;
+            int result = compressed && fread(compressed, 1, input_size, fp) == input_size
+                && zip_decompress(compressed, input_size, data, &output_size);
+            free(compressed);
+            return result;
+        }
+    }
+    if (!data) {
+        return fseek(fp, input_size, SEEK_CUR) == 0;
+    }
+    return fread(data, 1, input_size, fp) == input_size;
+}
+
+int game_file_io_read_saved_game_info(const char *filename, saved_game_info *info)
+{
+    if (!savegame_data.num_pieces) {
+        return 0;
+    }
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    memset(info, 0, sizeof(saved_game_info));
+    const savegame_state *state = &savegame_data.state;
+    uint8_t *city_data = 0;
+    uint8_t data[MAX_SCENARIO_NAME];
+    buffer buf;
+    int result = 1;
+    // Only the pieces holding the info are read, everything else is skipped without decompressing
+    for (int i = 0; i < savegame_data.num_pieces && result; i++) {
+        const file_piece *piece = &savegame_data.pieces[i];
+        const buffer *target = &piece->buf;
+        if (target == state->city_data) {
+            city_data = malloc(piece->size);
+            result = city_data && read_info_piece(fp, piece, city_data);
+            if (!result) {
+                break;
+            }
+            buffer_init(&buf, city_data, piece->size);
+            buffer_set(&buf, CITY_DATA_TREASURY_OFFSET);
+            info->treasury = buffer_read_i32(&buf);
+            buffer_set(&buf, CITY_DATA_POPULATION_OFFSET);
+            info->population = buffer_read_i32(&buf);
+        } else if (target == state->scenario_campaign_mission || target == state->scenario_is_custom
+            || target == state->game_time || target == state->scenario_name) {
+            result = read_info_piece(fp, piece, data);
+            buffer_init(&buf, data, piece->size);
+            if (target == state->scenario_campaign_mission) {
+                info->campaign_mission = buffer_read_i32(&buf);
+            } else if (target == state->scenario_is_custom) {
+                info->is_custom = buffer_read_i32(&buf);
+            } else if (target == state->game_time) {
+                buffer_skip(&buf, 8);
+                info->month = buffer_read_i32(&buf);
+                info->year = buffer_read_i32(&buf);
+            } else {
+                buffer_read_raw(&buf, info->scenario_name, MAX_SCENARIO_NAME);
+                info->scenario_name[MAX_SCENARIO_NAME - 1] = 0;
+                // Nothing of interest after the scenario name
+                break;
+            }
+        } else {
+            result = read_info_piece(fp, piece, 0);
+        }
+    }
+    free(city_data);
+    file_close(fp);
+    return result;
+}
+
+static int savegame_total_size(void)
+{
+    int size = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        size += savegame_data.pieces[i].buf.size;
+    }
+    return size;
+}
+
 int game_file_io_write_saved_game(const char *filename)
 {
+    game_file_io_wait_for_background_save();
     init_savegame_data();
 
     log_info("Saving game", filename, 0);
     savegame_version = SAVE_GAME_VERSION;
-    savegame_save_to_state(&savegame_data.state);
+    TRACE_CALL(savegame_save_to_state(&savegame_data.state));
 
     FILE *fp = file_open(filename, "wb");
     if (!fp) {
         log_error("Unable to save game", 0, 0);
         return 0;
     }
-    savegame_write_to_file(fp);
+    TRACE_CALL(savegame_write_to_file(fp));
+    file_close(fp);
+    return 1;
+}
+
+static int write_background_save(void *unused)
+{
+    uint64_t trace_start_time = trace_begin();
+    void *output = malloc(COMPRESS_BUFFER_SIZE);
+    const uint8_t *data = background_save.data;
+    for (int i = 0; i < background_save.num_pieces; i++) {
+        int size = background_save.piece_sizes[i];
+        if (!background_save.piece_compressed[i]) {
+            fwrite(data, 1, size, background_save.fp);
+        } else if (!output || !write_compressed_chunk(background_save.fp, data, size, output)) {
+            log_error("Unable to save game", 0, 0);
+            break;
+        }
+        data += size;
+    }
+    file_close(background_save.fp);
+    free(output);
+    trace_end("write_background_save", trace_start_time);
+    return 0;
+}
+
+int game_file_io_write_saved_game_in_background(const char *filename)
+{
+    game_file_io_wait_for_background_save();
+    init_savegame_data();
+
+    log_info("Saving game in the background", filename, 0);
+    savegame_version = SAVE_GAME_VERSION;
+    TRACE_CALL(savegame_save_to_state(&savegame_data.state));
+
+    int size = savegame_total_size();
+    background_save.data = malloc(size);
+    if (!background_save.data) {
+        return game_file_io_write_saved_game(filename);
+    }
+    // The file is opened here because opening a file updates the directory index
+    background_save.fp = file_open(filename, "wb");
+    if (!background_save.fp) {
+        log_error("Unable to save game", 0, 0);
+        free(background_save.data);
+        background_save.data = 0;
+        return 0;
+    }
+    uint8_t *dst = background_save.data;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const file_piece *piece = &savegame_data.pieces[i];
+        memcpy(dst, piece->buf.data, piece->buf.size);
+        dst += piece->buf.size;
+        background_save.piece_sizes[i] = piece->buf.size;
+        background_save.piece_compressed[i] = piece->compressed;
+    }
+    background_save.num_pieces = savegame_data.num_pieces;
+    background_save.worker = thread_create(write_background_save, 0, "save_game");
+    if (!background_save.worker) {
+        write_background_save(0);
+        free(background_save.data);
+        background_save.data = 0;
+    }
+    return 1;
+}
+
+void game_file_io_wait_for_background_save(void)
+{
+    if (background_save.worker) {
+        thread_wait(background_save.worker);
+        background_save.worker = 0;
+        free(background_save.data);
+        background_save.data = 0;
+    }
+}
+
+int game_file_io_write_quicksave(int slot)
+{
+    if (slot < 0 || slot >= MAX_QUICKSAVE_SLOTS) {
+        return 0;
+    }
+    game_file_io_wait_for_background_save();
+    init_savegame_data();
+
+    log_info("Quicksaving game to slot", 0, slot + 1);
+    savegame_version = SAVE_GAME_VERSION;
+    TRACE_CALL(savegame_save_to_state(&savegame_data.state));
+
+    int size = savegame_total_size();
+    if (size <= 0) {
+        return 0;
+    }
+    if (!quicksave_slots[slot].data) {
+        quicksave_slots[slot].data = (uint8_t *) malloc(size);
+        if (!quicksave_slots[slot].data) {
+            log_error("Unable to allocate memory for quicksave", 0, 0);
+            return 0;
+        }
+    }
+    uint8_t *dst = quicksave_slots[slot].data;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const buffer *buf = &savegame_data.pieces[i].buf;
+        memcpy(dst, buf->data, buf->size);
+        dst += buf->size;
+    }
+    quicksave_slots[slot].size = size;
+    return 1;
+}
+
+int game_file_io_read_quicksave(int slot)
+{
+    if (!game_file_io_has_quicksave(slot)) {
+        return 0;
+    }
+    game_file_io_wait_for_background_save();
+    init_savegame_data();
+
+    log_info("Quickloading game from slot", 0, slot + 1);
+    delta_autosave.valid = 0;
+    const uint8_t *src = quicksave_slots[slot].data;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        buffer *buf = &savegame_data.pieces[i].buf;
+        memcpy(buf->data, src, buf->size);
+        src += buf->size;
+    }
+    TRACE_CALL(savegame_load_from_state(&savegame_data.state));
+    return 1;
+}
+
+int game_file_io_has_quicksave(int slot)
+{
+    return slot >= 0 && slot < MAX_QUICKSAVE_SLOTS && quicksave_slots[slot].size > 0;
+}
+
+static int init_delta_autosave_data(void)
+{
+    if (delta_autosave.previous) {
+        return 1;
+    }
+    delta_autosave.size = savegame_total_size();
+    delta_autosave.previous = (uint8_t *) malloc(delta_autosave.size);
+    // Worst case: runs of one byte separated by gaps of DELTA_MIN_RUN_GAP bytes, each with an 8-byte header
+    delta_autosave.output = (uint8_t *) malloc(2 * delta_autosave.size);
+    if (!delta_autosave.previous || !delta_autosave.output) {
+        free(delta_autosave.previous);
+        free(delta_autosave.output);
+        delta_autosave.previous = 0;
+        delta_autosave.output = 0;
+        log_error("Unable to allocate memory for delta autosave", 0, 0);
+        return 0;
+    }
+    return 1;
+}
+
+static void copy_state_to_delta_snapshot(void)
+{
+    uint8_t *dst = delta_autosave.previous;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const buffer *buf = &savegame_data.pieces[i].buf;
+        memcpy(dst, buf->data, buf->size);
+        dst += buf->size;
+    }
+}
+
+static int write_delta_base(const char *base_filename, const char *delta_filename)
+{
+    if (!game_file_io_write_saved_game(base_filename)) {
+        return 0;
+    }
+    copy_state_to_delta_snapshot();
+
+    FILE *fp = file_open(delta_filename, "wb");
+    if (!fp) {
+        log_error("Unable to write delta autosave", delta_filename, 0);
+        return 0;
+    }
+    write_int32(fp, DELTA_FILE_VERSION);
+    write_int32(fp, delta_autosave.size);
+    file_close(fp);
+    return 1;
+}
+
+static int encode_piece_delta(const uint8_t *current, uint8_t *previous, int length, int offset, buffer *out)
+{
+    int num_runs = 0;
+    int i = 0;
+    while (i < length) {
+        if (current[i] == previous[i]) {
+            i++;
+            continue;
+        }
+        int start = i;
+        int end = i + 1;
+        int gap = 0;
+        for (i = end; i < length && gap < DELTA_MIN_RUN_GAP; i++) {
+            if (current[i] == previous[i]) {
+                gap++;
+            } else {
+                gap = 0;
+                end = i + 1;
+            }
+        }
+        buffer_write_i32(out, offset + start);
+        buffer_write_i32(out, end - start);
+        buffer_write_raw(out, &current[start], end - start);
+        memcpy(&previous[start], &current[start], end - start);
+        num_runs++;
+    }
+    return num_runs;
+}
+
+static int write_delta_month(const char *delta_filename)
+{
+    buffer out;
+    buffer_init(&out, delta_autosave.output, 2 * delta_autosave.size);
+    int num_runs = 0;
+    int offset = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const buffer *buf = &savegame_data.pieces[i].buf;
+        num_runs += encode_piece_delta(buf->data, &delta_autosave.previous[offset], buf->size, offset, &out);
+        offset += buf->size;
+    }
+
+    FILE *fp = file_open(delta_filename, "ab");
+    if (!fp) {
+        log_error("Unable to write delta autosave", delta_filename, 0);
+        return 0;
+    }
+    write_int32(fp, game_time_year());
+    write_int32(fp, game_time_month());
+    write_int32(fp, num_runs);
+    write_int32(fp, out.index);
+    if (out.index <= COMPRESS_BUFFER_SIZE) {
+        write_compressed_chunk(fp, out.data, out.index, compress_buffer);
+    } else {
+        write_int32(fp, UNCOMPRESSED);
+        fwrite(out.data, 1, out.index, fp);
+    }
     file_close(fp);
     return 1;
 }
 
+int game_file_io_write_delta_autosave(const char *base_filename, const char *delta_filename)
+{
+    game_file_io_wait_for_background_save();
+    if (!init_delta_autosave_data()) {
+        return game_file_io_write_saved_game(base_filename);
+    }
+    if (!delta_autosave.valid || delta_autosave.months_since_base >= DELTA_REBASE_MONTHS) {
+        delta_autosave.valid = write_delta_base(base_filename, delta_filename);
+        delta_autosave.months_since_base = 0;
+        return delta_autosave.valid;
+    }
+    init_savegame_data();
+    savegame_version = SAVE_GAME_VERSION;
+    TRACE_CALL(savegame_save_to_state(&savegame_data.state));
+
+    delta_autosave.valid = write_delta_month(delta_filename);
+    delta_autosave.months_since_base++;
+    return delta_autosave.valid;
+}
+
 int game_file_io_delete_saved_game(const char *filename)
 {
+    game_file_io_wait_for_background_save();
     log_info("Deleting game", filename, 0);
     int result = file_remove(filename);
     if (!result) {
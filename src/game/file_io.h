@@ -1,6 +1,22 @@
 #ifndef GAME_FILE_IO_H
 #define GAME_FILE_IO_H
 
+#include "scenario/data.h"
+
+#include <stdint.h>
+
+#define MAX_QUICKSAVE_SLOTS 4
+
+typedef struct {
+    uint8_t scenario_name[MAX_SCENARIO_NAME];
+    int campaign_mission;
+    int is_custom;
+    int month;
+    int year;
+    int population;
+    int treasury;
+} saved_game_info;
+
 int game_file_io_read_scenario(const char *filename);
 
 int game_file_io_write_scenario(const char *filename);
@@ -9,6 +25,42 @@ int game_file_io_read_saved_game(const char *filename, int offset);
 
 int game_file_io_write_saved_game(const char *filename);
 
+/**
+ * Saves the game, compressing and writing the file on a background thread.
+ * The game state is copied before returning, so the file is the same as with game_file_io_write_saved_game.
+ * @param filename File to save to
+ * @return Boolean true if the file could be opened, false otherwise
+ */
+int game_file_io_write_saved_game_in_background(const char *filename);
+
+/**
+ * Waits until the game that is being saved in the background has been written
+ */
+void game_file_io_wait_for_background_save(void);
+
+/**
+ * Sets up the saved game layout, must be called on the main thread
+ * before game_file_io_read_saved_game_info is used on another thread
+ */
+void game_file_io_init_saved_game_info(void);
+
+/**
+ * Reads the summary of a saved game without loading it. Does not touch the game state,
+ * so it is safe to call from a background thread.
+ * @param filename Exact name of the file
+ * @param info Output: summary of the saved game
+ * @return Boolean true on success, false on failure
+ */
+int game_file_io_read_saved_game_info(const char *filename, saved_game_info *info);
+
+int game_file_io_write_delta_autosave(const char *base_filename, const char *delta_filename);
+
+int game_file_io_write_quicksave(int slot);
+
+int game_file_io_read_quicksave(int slot);
+
+int game_file_io_has_quicksave(int slot);
+
 int game_file_io_delete_saved_game(const char *filename);
 
 #endif // GAME_FILE_IO_H
@@ -2,21 +2,27 @@
 
 #include "building/model.h"
 #include "city/view.h"
+#include "core/calc.h"
 #include "core/config.h"
 #include "core/hotkey_config.h"
 #include "core/image.h"
 #include "core/lang.h"
 #include "core/locale.h"
 #include "core/log.h"
+#include "core/parallel.h"
 #include "core/random.h"
+#include "core/thread.h"
 #include "editor/editor.h"
 #include "figure/type.h"
 #include "game/animation.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/file_io.h"
+#include "game/perf.h"
 #include "game/settings.h"
 #include "game/speed.h"
 #include "game/state.h"
+#include "game/system.h"
 #include "game/tick.h"
 #include "graphics/font.h"
 #include "graphics/video.h"
@@ -30,6 +36,18 @@
 #include "window/logo.h"
 #include "window/main_menu.h"
 
+#include <string.h>
+
+static struct {
+    thread *worker;
+    thread_semaphore *start;
+    thread_semaphore *done;
+    int worker_failed;
+    int is_running;
+    int stop_requested;
+    uint64_t last_frame_start;
+} simulation;
+
 static void errlog(const char *msg)
 {
     log_error(msg, 0, 0);
@@ -165,28 +183,124 @@ int game_reload_language(void)
     return reload_language(0, 1);
 }
 
+static void run_tick(void)
+{
+    uint64_t start = perf_start();
+    game_tick_run();
+    perf_stop_tick(start);
+    game_file_write_mission_saved_game();
+}
+
+static int run_ticks_for_frame(void)
+{
+    int fps = calc_bound(config_get(CONFIG_SCREEN_UNLIMITED_SPEED_FPS), 1, 60);
+    uint64_t frame_time = 1000000 / fps;
+    uint64_t now = system_get_time_us();
+    // Drawing the previous frame takes time from this one, unless the frame has been skipped altogether
+    uint64_t deadline = simulation.last_frame_start + frame_time;
+    if (deadline <= now || deadline > now + frame_time) {
+        deadline = now + frame_time;
+    }
+    simulation.last_frame_start = now;
+    int num_ticks = 0;
+    do {
+        run_tick();
+        num_ticks++;
+    } while (!window_is_invalid() && system_get_time_us() < deadline);
+    return num_ticks;
+}
+
 void game_run(void)
 {
     game_animation_update();
     int num_ticks = game_speed_get_elapsed_ticks();
-    for (int i = 0; i < num_ticks; i++) {
-        game_tick_run();
-        game_file_write_mission_saved_game();
+    if (num_ticks == GAME_SPEED_TICKS_UNLIMITED) {
+        num_ticks = run_ticks_for_frame();
+    } else {
+        for (int i = 0; i < num_ticks; i++) {
+            run_tick();
+
+            if (window_is_invalid()) {
+                num_ticks = i + 1;
+                break;
+            }
+        }
+    }
+    game_speed_add_ticks(num_ticks);
+}
 
-        if (window_is_invalid()) {
+static int run_simulation(void *unused)
+{
+    while (1) {
+        thread_semaphore_wait(simulation.start);
+        if (simulation.stop_requested) {
             break;
         }
+        game_run();
+        thread_semaphore_post(simulation.done);
+    }
+    return 0;
+}
+
+static void stop_simulation_thread(void)
+{
+    if (simulation.worker) {
+        game_run_wait();
+        simulation.stop_requested = 1;
+        thread_semaphore_post(simulation.start);
+        thread_wait(simulation.worker);
+    }
+    thread_semaphore_destroy(simulation.start);
+    thread_semaphore_destroy(simulation.done);
+    memset(&simulation, 0, sizeof(simulation));
+}
+
+static int start_simulation_thread(void)
+{
+    simulation.start = thread_semaphore_create(0);
+    simulation.done = thread_semaphore_create(0);
+    if (simulation.start && simulation.done) {
+        simulation.worker = thread_create(run_simulation, 0, "simulation");
+    }
+    if (!simulation.worker) {
+        stop_simulation_thread();
+        simulation.worker_failed = 1;
+        log_info("Unable to start simulation thread, running the simulation on the main thread", 0, 0);
+    }
+    return simulation.worker != 0;
+}
+
+void game_run_start(void)
+{
+    if (!simulation.worker && (simulation.worker_failed || !start_simulation_thread())) {
+        game_run();
+        return;
+    }
+    simulation.is_running = 1;
+    thread_semaphore_post(simulation.start);
+}
+
+void game_run_wait(void)
+{
+    if (simulation.is_running) {
+        thread_semaphore_wait(simulation.done);
+        simulation.is_running = 0;
     }
 }
 
 void game_draw(void)
 {
+    uint64_t start = perf_start();
     window_draw(0);
+    perf_stop(PERF_DRAW_UI, start);
     sound_city_play();
 }
 
 void game_exit(void)
 {
+    stop_simulation_thread();
+    parallel_shutdown();
+    game_file_io_wait_for_background_save();
     video_shutdown();
     settings_save();
     config_save();
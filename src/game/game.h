@@ -11,6 +11,19 @@ int game_reload_language(void);
 
 void game_run(void);
 
+/**
+ * Starts running the simulation for this frame on a background thread, so that it
+ * overlaps with presenting the frame. Falls back to running it right away when
+ * the platform cannot create threads.
+ * Nothing may touch the game state until game_run_wait() returns.
+ */
+void game_run_start(void);
+
+/**
+ * Waits for the simulation started by game_run_start() to finish
+ */
+void game_run_wait(void);
+
 void game_draw(void);
 
 void game_exit_editor(void);
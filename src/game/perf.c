@@ -0,0 +1,111 @@
+#include "perf.h"
+
+#include "game/system.h"
+#include "game/trace.h"
+
+#include <string.h>
+
+// Names for the trace events of the counters
+static const char *COUNTER_NAMES[PERF_MAX] = {
+    "frame", "game_tick_run", "draw footprints", "draw tops", "draw figures", "draw overlay", "window_draw",
+    "texture upload"
+};
+
+typedef struct {
+    int values[PERF_HISTORY_SIZE];
+    int newest;
+} history;
+
+static struct {
+    int enabled;
+    uint64_t last_frame;
+    uint64_t current[PERF_MAX];
+    history histories[PERF_MAX];
+} data;
+
+static void add_to_history(perf_counter counter, uint64_t time_us)
+{
+    history *h = &data.histories[counter];
+    h->newest = (h->newest + 1) % PERF_HISTORY_SIZE;
+    h->values[h->newest] = (int) time_us;
+}
+
+void perf_toggle(void)
+{
+    data.enabled = !data.enabled;
+    memset(data.current, 0, sizeof(data.current));
+    memset(data.histories, 0, sizeof(data.histories));
+    data.last_frame = 0;
+}
+
+int perf_is_enabled(void)
+{
+    return data.enabled;
+}
+
+uint64_t perf_start(void)
+{
+    return data.enabled || trace_is_recording() ? system_get_time_us() : 0;
+}
+
+void perf_stop(perf_counter counter, uint64_t start)
+{
+    if (!start) {
+        return;
+    }
+    if (data.enabled) {
+        data.current[counter] += system_get_time_us() - start;
+    }
+    trace_end(COUNTER_NAMES[counter], start);
+}
+
+void perf_stop_tick(uint64_t start)
+{
+    if (!start) {
+        return;
+    }
+    if (data.enabled) {
+        add_to_history(PERF_TICK, system_get_time_us() - start);
+    }
+    trace_end(COUNTER_NAMES[PERF_TICK], start);
+}
+
+void perf_end_frame(void)
+{
+    if (!data.enabled) {
+        return;
+    }
+    uint64_t now = system_get_time_us();
+    if (data.last_frame) {
+        data.current[PERF_FRAME] = now - data.last_frame;
+    }
+    data.last_frame = now;
+
+    // The UI is timed around the whole window, which includes the city passes
+    uint64_t city = data.current[PERF_DRAW_FOOTPRINTS] + data.current[PERF_DRAW_TOPS] +
+        data.current[PERF_DRAW_FIGURES] + data.current[PERF_DRAW_OVERLAY];
+    data.current[PERF_DRAW_UI] = data.current[PERF_DRAW_UI] > city ? data.current[PERF_DRAW_UI] - city : 0;
+
+    // Ticks run on the simulation thread and are added one at a time
+    for (int i = 0; i < PERF_MAX; i++) {
+        if (i != PERF_TICK) {
+            add_to_history(i, data.current[i]);
+            data.current[i] = 0;
+        }
+    }
+}
+
+int perf_get(perf_counter counter, int age)
+{
+    const history *h = &data.histories[counter];
+    return h->values[(h->newest + PERF_HISTORY_SIZE - age) % PERF_HISTORY_SIZE];
+}
+
+int perf_get_average(perf_counter counter)
+{
+    int total = 0;
+    for (int i = 0; i < PERF_HISTORY_SIZE; i++) {
+        total += data.histories[counter].values[i];
+    }
+    return total / PERF_HISTORY_SIZE;
+}
@@ -0,0 +1,70 @@
+#ifndef GAME_PERF_H
+#define GAME_PERF_H
+
+#include <stdint.h>
+
+#define PERF_HISTORY_SIZE 120
+
+typedef enum {
+    PERF_FRAME = 0,
+    PERF_TICK = 1,
+    PERF_DRAW_FOOTPRINTS = 2,
+    PERF_DRAW_TOPS = 3,
+    PERF_DRAW_FIGURES = 4,
+    PERF_DRAW_OVERLAY = 5,
+    PERF_DRAW_UI = 6,
+    PERF_TEXTURE_UPLOAD = 7,
+    PERF_MAX = 8
+} perf_counter;
+
+/**
+ * Turns collecting performance information on or off
+ */
+void perf_toggle(void);
+
+/**
+ * Checks whether performance information is being collected
+ * @return Boolean true if it is
+ */
+int perf_is_enabled(void);
+
+/**
+ * Starts timing a section of a frame. The section is also recorded as a trace event.
+ * @return Start time, or 0 when neither performance information nor a trace is being collected
+ */
+uint64_t perf_start(void);
+
+/**
+ * Adds the time since perf_start() to the counter for the current frame
+ * @param counter Counter to add to
+ * @param start Value returned by perf_start()
+ */
+void perf_stop(perf_counter counter, uint64_t start);
+
+/**
+ * Adds the time since perf_start() as the duration of a single simulation tick
+ * @param start Value returned by perf_start()
+ */
+void perf_stop_tick(uint64_t start);
+
+/**
+ * Moves the counters of the current frame to the history
+ */
+void perf_end_frame(void);
+
+/**
+ * Gets a value from the history of a counter
+ * @param counter Counter
+ * @param age 0 for the newest value, up to PERF_HISTORY_SIZE - 1
+ * @return Time in microseconds
+ */
+int perf_get(perf_counter counter, int age);
+
+/**
+ * Gets the average of a counter over its history
+ * @param counter Counter
+ * @return Time in microseconds
+ */
+int perf_get_average(perf_counter counter);
+
+#endif // GAME_PERF_H
@@ -0,0 +1,349 @@
+#include "save_index.h"
+
+#include "core/buffer.h"
+#include "core/file.h"
+#include "core/thread.h"
+#include "game/system.h"
+#include "platform/file_manager.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define INDEX_FILENAME "savegames.idx"
+#define INDEX_VERSION 1
+#define INDEX_HEADER_SIZE 8
+#define INDEX_ENTRY_SIZE (2 + FILE_NAME_MAX + 16 + MAX_SCENARIO_NAME + 24)
+
+// Time to spend indexing per frame when there is no background thread
+#define UPDATE_BUDGET_US 4000
+
+enum {
+    ENTRY_PENDING = 0,
+    ENTRY_READY = 1,
+    ENTRY_FAILED = 2
+};
+
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    int64_t size;
+    int64_t modified;
+    int state;
+    saved_game_info info;
+} index_entry;
+
+static struct {
+    index_entry *entries;
+    int num_entries;
+    index_entry *cached;
+    int num_cached;
+    int cache_loaded;
+    // The fields below are shared with the worker thread and protected by the mutex
+    int next_entry;
+    int num_done;
+    int stop_requested;
+    int changed;
+    thread *worker;
+    thread_mutex *mutex;
+} data;
+
+static int compare_entry(const void *filename, const void *entry)
+{
+    return platform_file_manager_compare_filename((const char *) filename, ((const index_entry *) entry)->filename);
+}
+
+static index_entry *find_entry(index_entry *entries, int num_entries, const char *filename)
+{
+    if (!entries) {
+        return 0;
+    }
+    return bsearch(filename, entries, num_entries, sizeof(index_entry), compare_entry);
+}
+
+static void read_int64(buffer *buf, int64_t *value)
+{
+    uint32_t low = buffer_read_u32(buf);
+    uint32_t high = buffer_read_u32(buf);
+    *value = (int64_t) (((uint64_t) high << 32) | low);
+}
+
+static void write_int64(buffer *buf, int64_t value)
+{
+    buffer_write_u32(buf, (uint32_t) ((uint64_t) value & 0xffffffff));
+    buffer_write_u32(buf, (uint32_t) ((uint64_t) value >> 32));
+}
+
+static int read_cache_entry(buffer *buf, index_entry *entry)
+{
+    int name_length = buffer_read_u16(buf);
+    if (name_length <= 0 || name_length >= FILE_NAME_MAX) {
+        return 0;
+    }
+    buffer_read_raw(buf, entry->filename, name_length);
+    entry->filename[name_length] = 0;
+    read_int64(buf, &entry->size);
+    read_int64(buf, &entry->modified);
+    buffer_read_raw(buf, entry->info.scenario_name, MAX_SCENARIO_NAME);
+    entry->info.scenario_name[MAX_SCENARIO_NAME - 1] = 0;
+    entry->info.campaign_mission = buffer_read_i32(buf);
+    entry->info.is_custom = buffer_read_i32(buf);
+    entry->info.month = buffer_read_i32(buf);
+    entry->info.year = buffer_read_i32(buf);
+    entry->info.population = buffer_read_i32(buf);
+    entry->info.treasury = buffer_read_i32(buf);
+    entry->state = ENTRY_READY;
+    return !buf->overflow;
+}
+
+static void write_cache_entry(buffer *buf, const index_entry *entry)
+{
+    int name_length = (int) strlen(entry->filename);
+    buffer_write_u16(buf, name_length);
+    buffer_write_raw(buf, entry->filename, name_length);
+    write_int64(buf, entry->size);
+    write_int64(buf, entry->modified);
+    buffer_write_raw(buf, entry->info.scenario_name, MAX_SCENARIO_NAME);
+    buffer_write_i32(buf, entry->info.campaign_mission);
+    buffer_write_i32(buf, entry->info.is_custom);
+    buffer_write_i32(buf, entry->info.month);
+    buffer_write_i32(buf, entry->info.year);
+    buffer_write_i32(buf, entry->info.population);
+    buffer_write_i32(buf, entry->info.treasury);
+}
+
+static int compare_cached(const void *va, const void *vb)
+{
+    return platform_file_manager_compare_filename(((const index_entry *) va)->filename,
+        ((const index_entry *) vb)->filename);
+}
+
+static void load_cache(void)
+{
+    data.cache_loaded = 1;
+    FILE *fp = file_open(INDEX_FILENAME, "rb");
+    if (!fp) {
+        return;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    rewind(fp);
+    uint8_t *contents = size > INDEX_HEADER_SIZE ? malloc(size) : 0;
+    if (!contents || fread(contents, 1, size, fp) != (size_t) size) {
+        free(contents);
+        file_close(fp);
+        return;
+    }
+    file_close(fp);
+
+    buffer buf;
+    buffer_init(&buf, contents, (int) size);
+    int version = buffer_read_i32(&buf);
+    int num_entries = buffer_read_i32(&buf);
+    if (version == INDEX_VERSION && num_entries > 0 && num_entries <= size / 4) {
+        data.cached = malloc(num_entries * sizeof(index_entry));
+    }
+    if (data.cached) {
+        while (data.num_cached < num_entries && read_cache_entry(&buf, &data.cached[data.num_cached])) {
+            data.num_cached++;
+        }
+        // Filenames may compare differently on another platform, so sort again before searching
+        qsort(data.cached, data.num_cached, sizeof(index_entry), compare_cached);
+    }
+    free(contents);
+}
+
+static void write_cache(void)
+{
+    // Keeps the cached summary for files that were not checked yet, they will be verified next time
+    int num_entries = 0;
+    for (int i = 0; i < data.num_entries; i++) {
+        if (data.entries[i].state == ENTRY_READY
+            || find_entry(data.cached, data.num_cached, data.entries[i].filename)) {
+            num_entries++;
+        }
+    }
+    int size = INDEX_HEADER_SIZE + num_entries * INDEX_ENTRY_SIZE;
+    uint8_t *contents = malloc(size);
+    if (!contents) {
+        return;
+    }
+    buffer buf;
+    buffer_init(&buf, contents, size);
+    buffer_write_i32(&buf, INDEX_VERSION);
+    buffer_write_i32(&buf, num_entries);
+    for (int i = 0; i < data.num_entries; i++) {
+        const index_entry *entry = &data.entries[i];
+        if (entry->state != ENTRY_READY) {
+            entry = find_entry(data.cached, data.num_cached, entry->filename);
+        }
+        if (entry) {
+            write_cache_entry(&buf, entry);
+        }
+    }
+    FILE *fp = file_open(INDEX_FILENAME, "wb");
+    if (fp) {
+        fwrite(contents, 1, buf.index, fp);
+        file_close(fp);
+    }
+    free(contents);
+}
+
+static void index_file(const char *filename, index_entry *result)
+{
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        result->state = ENTRY_FAILED;
+        return;
+    }
+    int has_stamp = file_get_stamp(fp, &result->size, &result->modified);
+    file_close(fp);
+    if (!has_stamp) {
+        result->state = ENTRY_FAILED;
+        return;
+    }
+    const index_entry *cached = find_entry(data.cached, data.num_cached, filename);
+    if (cached && cached->size == result->size && cached->modified == result->modified) {
+        result->info = cached->info;
+        result->state = ENTRY_READY;
+        return;
+    }
+    result->state = game_file_io_read_saved_game_info(filename, &result->info) ? ENTRY_READY : ENTRY_FAILED;
+    thread_mutex_lock(data.mutex);
+    data.changed = 1;
+    thread_mutex_unlock(data.mutex);
+}
+
+static int index_next_file(void)
+{
+    thread_mutex_lock(data.mutex);
+    if (data.stop_requested || data.next_entry >= data.num_entries) {
+        thread_mutex_unlock(data.mutex);
+        return 0;
+    }
+    index_entry *entry = &data.entries[data.next_entry++];
+    thread_mutex_unlock(data.mutex);
+
+    // The filename never changes, everything else is only published once complete
+    index_entry result;
+    memset(&result, 0, sizeof(index_entry));
+    index_file(entry->filename, &result);
+
+    thread_mutex_lock(data.mutex);
+    entry->size = result.size;
+    entry->modified = result.modified;
+    entry->info = result.info;
+    entry->state = result.state;
+    data.num_done++;
+    thread_mutex_unlock(data.mutex);
+    return 1;
+}
+
+static int run_worker(void *unused)
+{
+    load_cache();
+    while (index_next_file()) {
+        // keep going
+    }
+    return 0;
+}
+
+void save_index_start(const dir_listing *files)
+{
+    save_index_stop();
+    if (!files->num_files) {
+        return;
+    }
+    game_file_io_init_saved_game_info();
+    data.entries = calloc(files->num_files, sizeof(index_entry));
+    if (!data.entries) {
+        return;
+    }
+    data.num_entries = files->num_files;
+    for (int i = 0; i < data.num_entries; i++) {
+        strncpy(data.entries[i].filename, files->files[i], FILE_NAME_MAX - 1);
+    }
+    data.mutex = thread_mutex_create();
+    if (data.mutex) {
+        data.worker = thread_create(run_worker, 0, "save_index");
+    }
+}
+
+void save_index_update(void)
+{
+    if (!data.entries) {
+        return;
+    }
+    if (data.worker) {
+        if (save_index_is_complete()) {
+            thread_wait(data.worker);
+            data.worker = 0;
+            if (data.changed) {
+                write_cache();
+                data.changed = 0;
+            }
+        }
+        return;
+    }
+    if (save_index_is_complete()) {
+        return;
+    }
+    uint64_t start = system_get_time_us();
+    if (!data.cache_loaded) {
+        load_cache();
+    }
+    while (system_get_time_us() - start < UPDATE_BUDGET_US && index_next_file()) {
+        // keep going
+    }
+    if (save_index_is_complete() && data.changed) {
+        write_cache();
+        data.changed = 0;
+    }
+}
+
+void save_index_stop(void)
+{
+    if (data.worker) {
+        thread_mutex_lock(data.mutex);
+        data.stop_requested = 1;
+        thread_mutex_unlock(data.mutex);
+        thread_wait(data.worker);
+    }
+    if (data.changed) {
+        write_cache();
+    }
+    thread_mutex_destroy(data.mutex);
+    free(data.entries);
+    free(data.cached);
+    memset(&data, 0, sizeof(data));
+}
+
+int save_index_is_complete(void)
+{
+    thread_mutex_lock(data.mutex);
+    int complete = data.num_done >= data.num_entries;
+    thread_mutex_unlock(data.mutex);
+    return complete;
+}
+
+static const index_entry *get_ready_entry(const char *filename)
+{
+    index_entry *entry = find_entry(data.entries, data.num_entries, filename);
+    if (!entry) {
+        return 0;
+    }
+    thread_mutex_lock(data.mutex);
+    int state = entry->state;
+    thread_mutex_unlock(data.mutex);
+    return state == ENTRY_READY ? entry : 0;
+}
+
+const saved_game_info *save_index_get(const char *filename)
+{
+    const index_entry *entry = get_ready_entry(filename);
+    return entry ? &entry->info : 0;
+}
+
+int64_t save_index_get_modified_time(const char *filename)
+{
+    const index_entry *entry = get_ready_entry(filename);
+    return entry ? entry->modified : 0;
+}
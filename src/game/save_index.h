@@ -0,0 +1,52 @@
+#ifndef GAME_SAVE_INDEX_H
+#define GAME_SAVE_INDEX_H
+
+#include "core/dir.h"
+#include "game/file_io.h"
+
+/**
+ * @file
+ * Index of saved game summaries for the file dialog.
+ *
+ * Summaries are cached in a file next to the saved games, keyed by filename, size and modification time,
+ * so only new or changed saved games have to be read. The index is built on a background thread when
+ * the platform supports it, otherwise a few files are read on every call to save_index_update().
+ */
+
+/**
+ * Starts indexing the given files, stopping any previous indexing
+ * @param files Saved games to index, sorted by filename
+ */
+void save_index_start(const dir_listing *files);
+
+/**
+ * Continues indexing, to be called every frame while the index is in use
+ */
+void save_index_update(void);
+
+/**
+ * Stops indexing, stores what is known so far and releases the index
+ */
+void save_index_stop(void);
+
+/**
+ * Checks whether all files have been indexed
+ * @return Boolean true if indexing is complete, false otherwise
+ */
+int save_index_is_complete(void);
+
+/**
+ * Gets the summary of a saved game
+ * @param filename Filename as passed in the listing
+ * @return Summary, or 0 if it is not (yet) known
+ */
+const saved_game_info *save_index_get(const char *filename);
+
+/**
+ * Gets the last modification time of a saved game
+ * @param filename Filename as passed in the listing
+ * @return Modification time, or 0 if it is not (yet) known
+ */
+int64_t save_index_get_modified_time(const char *filename);
+
+#endif // GAME_SAVE_INDEX_H
@@ -114,6 +114,17 @@ static void load_settings(buffer *buf)
     }
 }
 
+static int bound_game_speed(int speed)
+{
+    if (speed == GAME_SPEED_UNLIMITED) {
+        return speed;
+    } else if (speed > 100) {
+        return calc_bound(speed - speed % 100, 100, 500);
+    } else {
+        return calc_bound(speed, 10, 100);
+    }
+}
+
 void settings_load(void)
 {
     load_default_settings();
@@ -135,6 +146,7 @@ void settings_load(void)
     if (data.last_advisor <= ADVISOR_NONE || data.last_advisor > ADVISOR_CHIEF) {
         data.last_advisor = ADVISOR_LABOR;
     }
+    data.game_speed = bound_game_speed(data.game_speed);
 }
 
 void settings_save(void)
@@ -150,7 +162,8 @@ void settings_save(void)
     buffer_write_u8(buf, data.sound_music.enabled);
     buffer_write_u8(buf, data.sound_speech.enabled);
     buffer_skip(buf, 6);
-    buffer_write_i32(buf, data.game_speed);
+    // Caesar 3 reads this file as well and only knows speeds up to 500
+    buffer_write_i32(buf, data.game_speed == GAME_SPEED_UNLIMITED ? 500 : data.game_speed);
     buffer_write_i32(buf, data.scroll_speed);
     buffer_write_raw(buf, data.player_name, MAX_PLAYER_NAME);
     buffer_skip(buf, 16);
@@ -259,6 +272,8 @@ void setting_increase_game_speed(void)
     if (data.game_speed >= 100) {
         if (data.game_speed < 500) {
             data.game_speed += 100;
+        } else {
+            data.game_speed = GAME_SPEED_UNLIMITED;
         }
     } else {
         data.game_speed = calc_bound(data.game_speed + 10, 10, 100);
@@ -267,7 +282,9 @@ void setting_increase_game_speed(void)
 
 void setting_decrease_game_speed(void)
 {
-    if (data.game_speed > 100) {
+    if (data.game_speed > 500) {
+        data.game_speed = 500;
+    } else if (data.game_speed > 100) {
         data.game_speed -= 100;
     } else {
         data.game_speed = calc_bound(data.game_speed - 10, 10, 100);
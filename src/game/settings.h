@@ -45,6 +45,11 @@ void setting_increase_sound_volume(set_sound_type type);
 void setting_decrease_sound_volume(set_sound_type type);
 void setting_reset_sound(set_sound_type type, int enabled, int volume);
 
+/**
+ * Game speed that runs as many ticks as fit in a frame, only drawing a few frames per second
+ */
+#define GAME_SPEED_UNLIMITED 1000
+
 int setting_game_speed(void);
 void setting_increase_game_speed(void);
 void setting_decrease_game_speed(void);
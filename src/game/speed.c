@@ -19,6 +19,9 @@ static const time_millis MILLIS_PER_HYPER_SPEED[] = {
 static struct {
     int last_check_was_valid;
     time_millis last_update;
+    time_millis rate_start;
+    int rate_ticks;
+    int ticks_per_second;
 } data;
 
 int game_speed_get_elapsed_ticks(void)
@@ -41,6 +44,8 @@ int game_speed_get_elapsed_ticks(void)
             int speed = setting_game_speed();
             if (speed < 10) {
                 return 0;
+            } else if (speed >= GAME_SPEED_UNLIMITED) {
+                millis_per_tick = 0;
             } else if (speed <= 100) {
                 millis_per_tick = MILLIS_PER_TICK_PER_SPEED[speed / 10];
             } else {
@@ -70,6 +75,10 @@ int game_speed_get_elapsed_ticks(void)
         data.last_update = now;
         return 1;
     }
+    if (!millis_per_tick) {
+        data.last_update = now;
+        return GAME_SPEED_TICKS_UNLIMITED;
+    }
     int ticks = diff / millis_per_tick;
     if (!ticks) {
         return 0;
@@ -81,3 +90,19 @@ int game_speed_get_elapsed_ticks(void)
         return MAX_TICKS_PER_FRAME;
     }
 }
+
+void game_speed_add_ticks(int ticks)
+{
+    time_millis now = time_get_millis();
+    data.rate_ticks += ticks;
+    if (now - data.rate_start >= 1000) {
+        data.ticks_per_second = (int) (data.rate_ticks * 1000LL / (now - data.rate_start));
+        data.rate_start = now;
+        data.rate_ticks = 0;
+    }
+}
+
+int game_speed_get_ticks_per_second(void)
+{
+    return data.ticks_per_second;
+}
@@ -1,6 +1,27 @@
 #ifndef GAME_SPEED_H
 #define GAME_SPEED_H
 
+/**
+ * Returned by game_speed_get_elapsed_ticks() when as many ticks should be run as fit in the frame
+ */
+#define GAME_SPEED_TICKS_UNLIMITED -1
+
+/**
+ * Gets the number of ticks to run this frame
+ * @return Number of ticks, or GAME_SPEED_TICKS_UNLIMITED
+ */
 int game_speed_get_elapsed_ticks(void);
 
+/**
+ * Keeps track of the number of ticks that were run, for game_speed_get_ticks_per_second()
+ * @param ticks Number of ticks run this frame
+ */
+void game_speed_add_ticks(int ticks);
+
+/**
+ * Gets the number of ticks that were run during the last second
+ * @return Ticks per second
+ */
+int game_speed_get_ticks_per_second(void);
+
 #endif // GAME_SPEED_H
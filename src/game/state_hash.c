@@ -0,0 +1,58 @@
+#include "state_hash.h"
+
+#include "building/building.h"
+#include "city/data.h"
+#include "core/hash.h"
+#include "core/random.h"
+#include "figure/figure.h"
+#include "figure/formation.h"
+#include "figure/route.h"
+#include "game/time.h"
+#include "map/aqueduct.h"
+#include "map/building.h"
+#include "map/desirability.h"
+#include "map/elevation.h"
+#include "map/figure.h"
+#include "map/image.h"
+#include "map/property.h"
+#include "map/random.h"
+#include "map/routing.h"
+#include "map/sprite.h"
+#include "map/terrain.h"
+
+static const struct {
+    const char *name;
+    uint64_t (*hash)(void);
+} PARTS[STATE_HASH_MAX] = {
+    {"random", random_hash_state},
+    {"time", game_time_hash_state},
+    {"city", city_data_hash_state},
+    {"buildings", building_hash_state},
+    {"figures", figure_hash_state},
+    {"routes", figure_route_hash_state},
+    {"formations", formations_hash_state},
+    {"terrain_grid", map_terrain_hash_state},
+    {"image_grid", map_image_hash_state},
+    {"building_grid", map_building_hash_state},
+    {"figure_grid", map_figure_hash_state},
+    {"property_grid", map_property_hash_state},
+    {"aqueduct_grid", map_aqueduct_hash_state},
+    {"sprite_grid", map_sprite_hash_state},
+    {"random_grid", map_random_hash_state},
+    {"desirability_grid", map_desirability_hash_state},
+    {"elevation_grid", map_elevation_hash_state},
+    {"routing_grid", map_routing_hash_state}
+};
+
+void state_hash_calculate(state_hash *hash)
+{
+    for (int i = 0; i < STATE_HASH_MAX; i++) {
+        hash->parts[i] = PARTS[i].hash();
+    }
+    hash->total = hash_xxh64(hash->parts, sizeof(hash->parts), 0);
+}
+
+const char *state_hash_part_name(state_hash_part part)
+{
+    return PARTS[part].name;
+}
@@ -0,0 +1,48 @@
+#ifndef GAME_STATE_HASH_H
+#define GAME_STATE_HASH_H
+
+#include <stdint.h>
+
+typedef enum {
+    STATE_HASH_RANDOM = 0,
+    STATE_HASH_TIME = 1,
+    STATE_HASH_CITY = 2,
+    STATE_HASH_BUILDINGS = 3,
+    STATE_HASH_FIGURES = 4,
+    STATE_HASH_ROUTES = 5,
+    STATE_HASH_FORMATIONS = 6,
+    STATE_HASH_TERRAIN_GRID = 7,
+    STATE_HASH_IMAGE_GRID = 8,
+    STATE_HASH_BUILDING_GRID = 9,
+    STATE_HASH_FIGURE_GRID = 10,
+    STATE_HASH_PROPERTY_GRID = 11,
+    STATE_HASH_AQUEDUCT_GRID = 12,
+    STATE_HASH_SPRITE_GRID = 13,
+    STATE_HASH_RANDOM_GRID = 14,
+    STATE_HASH_DESIRABILITY_GRID = 15,
+    STATE_HASH_ELEVATION_GRID = 16,
+    STATE_HASH_ROUTING_GRID = 17,
+    STATE_HASH_MAX = 18
+} state_hash_part;
+
+typedef struct {
+    uint64_t total;
+    uint64_t parts[STATE_HASH_MAX];
+} state_hash;
+
+/**
+ * Hashes the simulation state, one hash for each part of it.
+ * The live data is hashed as it is in memory, so the hashes can only be compared
+ * between builds in which the state structs have the same layout.
+ * @param hash Hash to fill
+ */
+void state_hash_calculate(state_hash *hash);
+
+/**
+ * Gets the name of a part of the state
+ * @param part Part
+ * @return Name without spaces, for use in hash traces
+ */
+const char *state_hash_part_name(state_hash_part part);
+
+#endif // GAME_STATE_HASH_H
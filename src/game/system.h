@@ -4,6 +4,8 @@
 #include "graphics/color.h"
 #include "input/keys.h"
 
+#include <stdint.h>
+
 /**
  * @file
  * Functions that should implemented by the underlying system
@@ -152,6 +154,12 @@ void system_set_mouse_position(int *x, int *y);
  */
 color_t *system_create_framebuffer(int width, int height);
 
+/**
+ * Gets a high resolution timestamp, to be used for profiling only
+ * @return Time in microseconds since an unspecified starting point
+ */
+uint64_t system_get_time_us(void);
+
 /**
  * Exit the game
  */
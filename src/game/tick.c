@@ -26,6 +26,7 @@
 #include "city/sentiment.h"
 #include "city/trade.h"
 #include "city/victory.h"
+#include "core/config.h"
 #include "core/random.h"
 #include "editor/editor.h"
 #include "empire/city.h"
@@ -34,6 +35,7 @@
 #include "game/file.h"
 #include "game/settings.h"
 #include "game/time.h"
+#include "game/trace.h"
 #include "game/tutorial.h"
 #include "game/undo.h"
 #include "map/desirability.h"
@@ -84,13 +86,13 @@ static void advance_month(void)
     formation_update_monthly_morale_at_rest();
     city_message_decrease_delays();
 
-    map_tiles_update_all_roads();
-    map_tiles_update_all_water();
-    map_routing_update_land_citizen();
-    city_message_sort_and_compact();
+    TRACE_CALL(map_tiles_update_all_roads());
+    TRACE_CALL(map_tiles_update_all_water());
+    TRACE_CALL(map_routing_update_land_citizen());
+    TRACE_CALL(city_message_sort_and_compact());
 
     if (game_time_advance_month()) {
-        advance_year();
+        TRACE_CALL(advance_year());
     } else {
         city_ratings_update(0);
     }
@@ -99,14 +101,18 @@ static void advance_month(void)
     city_festival_update();
     tutorial_on_month_tick();
     if (setting_monthly_autosave()) {
-        game_file_write_saved_game("autosave.sav");
+        if (config_get(CONFIG_GENERAL_DELTA_AUTOSAVE)) {
+            game_file_write_delta_autosave("autosave.sav", "autosave.delta");
+        } else {
+            game_file_write_saved_game_in_background("autosave.sav");
+        }
     }
 }
 
 static void advance_day(void)
 {
     if (game_time_advance_day()) {
-        advance_month();
+        TRACE_CALL(advance_month());
     }
     if (game_time_day() == 0 || game_time_day() == 8) {
         city_sentiment_update();
@@ -119,46 +125,46 @@ static void advance_tick(void)
     // NB: these ticks are noop:
     // 0, 9, 11, 13, 14, 15, 26, 41, 42, 47
     switch (game_time_tick()) {
-        case 1: city_gods_calculate_moods(1); break;
-        case 2: sound_music_update(0); break;
-        case 3: widget_minimap_invalidate(); break;
-        case 4: city_emperor_update(); break;
-        case 5: formation_update_all(0); break;
-        case 6: map_natives_check_land(); break;
-        case 7: map_road_network_update(); break;
-        case 8: building_granaries_calculate_stocks(); break;
-        case 10: building_update_highest_id(); break;
-        case 12: house_service_decay_houses_covered(); break;
-        case 16: city_resource_calculate_warehouse_stocks(); break;
-        case 17: city_resource_calculate_food_stocks_and_supply_wheat(); break;
-        case 18: city_resource_calculate_workshop_stocks(); break;
-        case 19: building_dock_update_open_water_access(); break;
-        case 20: building_industry_update_production(); break;
-        case 21: building_maintenance_check_rome_access(); break;
-        case 22: house_population_update_room(); break;
-        case 23: house_population_update_migration(); break;
-        case 24: house_population_evict_overcrowded(); break;
-        case 25: city_labor_update(); break;
-        case 27: map_water_supply_update_reservoir_fountain(); break;
-        case 28: map_water_supply_update_houses(); break;
-        case 29: formation_update_all(1); break;
-        case 30: widget_minimap_invalidate(); break;
-        case 31: building_figure_generate(); break;
-        case 32: city_trade_update(); break;
-        case 33: building_count_update(); city_culture_update_coverage(); break;
-        case 34: building_government_distribute_treasury(); break;
-        case 35: house_service_decay_culture(); break;
-        case 36: house_service_calculate_culture_aggregates(); break;
-        case 37: map_desirability_update(); break;
-        case 38: building_update_desirability(); break;
-        case 39: building_house_process_evolve_and_consume_goods(); break;
-        case 40: building_update_state(); break;
-        case 43: building_maintenance_update_burning_ruins(); break;
-        case 44: building_maintenance_check_fire_collapse(); break;
-        case 45: figure_generate_criminals(); break;
-        case 46: building_industry_update_wheat_production(); break;
-        case 48: house_service_decay_tax_collector(); break;
-        case 49: city_culture_calculate(); break;
+        case 1: TRACE_CALL(city_gods_calculate_moods(1)); break;
+        case 2: TRACE_CALL(sound_music_update(0)); break;
+        case 3: TRACE_CALL(widget_minimap_invalidate()); break;
+        case 4: TRACE_CALL(city_emperor_update()); break;
+        case 5: TRACE_CALL(formation_update_all(0)); break;
+        case 6: TRACE_CALL(map_natives_check_land()); break;
+        case 7: TRACE_CALL(map_road_network_update()); break;
+        case 8: TRACE_CALL(building_granaries_calculate_stocks()); break;
+        case 10: TRACE_CALL(building_update_highest_id()); break;
+        case 12: TRACE_CALL(house_service_decay_houses_covered()); break;
+        case 16: TRACE_CALL(city_resource_calculate_warehouse_stocks()); break;
+        case 17: TRACE_CALL(city_resource_calculate_food_stocks_and_supply_wheat()); break;
+        case 18: TRACE_CALL(city_resource_calculate_workshop_stocks()); break;
+        case 19: TRACE_CALL(building_dock_update_open_water_access()); break;
+        case 20: TRACE_CALL(building_industry_update_production()); break;
+        case 21: TRACE_CALL(building_maintenance_check_rome_access()); break;
+        case 22: TRACE_CALL(house_population_update_room()); break;
+        case 23: TRACE_CALL(house_population_update_migration()); break;
+        case 24: TRACE_CALL(house_population_evict_overcrowded()); break;
+        case 25: TRACE_CALL(city_labor_update()); break;
+        case 27: TRACE_CALL(map_water_supply_update_reservoir_fountain()); break;
+        case 28: TRACE_CALL(map_water_supply_update_houses()); break;
+        case 29: TRACE_CALL(formation_update_all(1)); break;
+        case 30: TRACE_CALL(widget_minimap_invalidate()); break;
+        case 31: TRACE_CALL(building_figure_generate()); break;
+        case 32: TRACE_CALL(city_trade_update()); break;
+        case 33: TRACE_CALL(building_count_update()); TRACE_CALL(city_culture_update_coverage()); break;
+        case 34: TRACE_CALL(building_government_distribute_treasury()); break;
+        case 35: TRACE_CALL(house_service_decay_culture()); break;
+        case 36: TRACE_CALL(house_service_calculate_culture_aggregates()); break;
+        case 37: TRACE_CALL(map_desirability_update()); break;
+        case 38: TRACE_CALL(building_update_desirability()); break;
+        case 39: TRACE_CALL(building_house_process_evolve_and_consume_goods()); break;
+        case 40: TRACE_CALL(building_update_state()); break;
+        case 43: TRACE_CALL(building_maintenance_update_burning_ruins()); break;
+        case 44: TRACE_CALL(building_maintenance_check_fire_collapse()); break;
+        case 45: TRACE_CALL(figure_generate_criminals()); break;
+        case 46: TRACE_CALL(building_industry_update_wheat_production()); break;
+        case 48: TRACE_CALL(house_service_decay_tax_collector()); break;
+        case 49: TRACE_CALL(city_culture_calculate()); break;
     }
     if (game_time_advance_tick()) {
         advance_day();
@@ -175,7 +181,7 @@ void game_tick_run(void)
     random_generate_next();
     game_undo_reduce_time_available();
     advance_tick();
-    figure_action_handle();
+    TRACE_CALL(figure_action_handle());
     scenario_earthquake_process();
     scenario_gladiator_revolt_process();
     scenario_emperor_change_process();
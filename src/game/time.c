@@ -1,5 +1,7 @@
 #include "time.h"
 
+#include "core/hash.h"
+
 static struct {
     int tick; // 50 ticks in a day
     int day; // 16 days in a month
@@ -87,3 +89,8 @@ void game_time_load_state(buffer *buf)
     data.year = buffer_read_i32(buf);
     data.total_days = buffer_read_i32(buf);
 }
+
+uint64_t game_time_hash_state(void)
+{
+    return hash_xxh64(&data, sizeof(data), 0);
+}
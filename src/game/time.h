@@ -73,4 +73,10 @@ void game_time_save_state(buffer *buf);
  */
 void game_time_load_state(buffer *buf);
 
+/**
+ * Hashes the game time, to check that two runs are the same
+ * @return Hash of the game time
+ */
+uint64_t game_time_hash_state(void);
+
 #endif // GAME_TIME_H
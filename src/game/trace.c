@@ -0,0 +1,131 @@
+#include "trace.h"
+
+#include "core/file.h"
+#include "core/log.h"
+#include "core/thread.h"
+#include "game/system.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MAX_EVENTS 131072
+
+typedef struct {
+    const char *name;
+    uint64_t start;
+    uint64_t duration;
+    unsigned long thread_id;
+} trace_event;
+
+static struct {
+    int recording;
+    trace_event *events;
+    int next;
+    int count;
+    thread_mutex *mutex;
+} data;
+
+int trace_start(void)
+{
+    if (data.recording) {
+        return 1;
+    }
+    if (!data.mutex) {
+        data.mutex = thread_mutex_create();
+    }
+    data.events = (trace_event *) malloc(MAX_EVENTS * sizeof(trace_event));
+    if (!data.events) {
+        log_error("Not enough memory to record a trace", 0, 0);
+        return 0;
+    }
+    data.next = 0;
+    data.count = 0;
+    data.recording = 1;
+    log_info("Recording trace", 0, 0);
+    return 1;
+}
+
+void trace_stop(void)
+{
+    if (!data.recording) {
+        return;
+    }
+    // Events may still be ended on other threads, the mutex makes sure they see the buffer go away
+    thread_mutex_lock(data.mutex);
+    data.recording = 0;
+    free(data.events);
+    data.events = 0;
+    thread_mutex_unlock(data.mutex);
+}
+
+int trace_is_recording(void)
+{
+    return data.recording;
+}
+
+uint64_t trace_begin(void)
+{
+    return data.recording ? system_get_time_us() : 0;
+}
+
+void trace_end(const char *name, uint64_t start)
+{
+    if (!start) {
+        return;
+    }
+    uint64_t now = system_get_time_us();
+    unsigned long thread_id = thread_current_id();
+    thread_mutex_lock(data.mutex);
+    if (data.events) {
+        trace_event *event = &data.events[data.next];
+        event->name = name;
+        event->start = start;
+        event->duration = now - start;
+        event->thread_id = thread_id;
+        data.next = (data.next + 1) % MAX_EVENTS;
+        if (data.count < MAX_EVENTS) {
+            data.count++;
+        }
+    }
+    thread_mutex_unlock(data.mutex);
+}
+
+static void write_name(FILE *fp, const char *name)
+{
+    fputc('"', fp);
+    for (const char *c = name; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', fp);
+        }
+        fputc(*c, fp);
+    }
+    fputc('"', fp);
+}
+
+int trace_save(const char *filename)
+{
+    if (!data.recording) {
+        return 0;
+    }
+    FILE *fp = file_open(filename, "w");
+    if (!fp) {
+        log_error("Unable to write trace to:", filename, 0);
+        return 0;
+    }
+    thread_mutex_lock(data.mutex);
+    fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    int first = (data.next - data.count + MAX_EVENTS) % MAX_EVENTS;
+    for (int i = 0; i < data.count; i++) {
+        const trace_event *event = &data.events[(first + i) % MAX_EVENTS];
+        fprintf(fp, "%s\n{\"name\": ", i ? "," : "");
+        write_name(fp, event->name);
+        fprintf(fp, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %lu, \"ts\": %llu, \"dur\": %llu}",
+            event->thread_id, (unsigned long long) event->start, (unsigned long long) event->duration);
+    }
+    int count = data.count;
+    thread_mutex_unlock(data.mutex);
+    fprintf(fp, "\n]}\n");
+    file_close(fp);
+    log_info("Saved trace events:", filename, count);
+    return 1;
+}
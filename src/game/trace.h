@@ -0,0 +1,49 @@
+#ifndef GAME_TRACE_H
+#define GAME_TRACE_H
+
+#include <stdint.h>
+
+/**
+ * Starts recording trace events. Only the most recent events are kept.
+ * @return Boolean true if recording was started
+ */
+int trace_start(void);
+
+/**
+ * Stops recording and releases the recorded events
+ */
+void trace_stop(void);
+
+/**
+ * Checks whether trace events are being recorded
+ * @return Boolean true if they are
+ */
+int trace_is_recording(void);
+
+/**
+ * Starts a trace event
+ * @return Start time, or 0 when no events are being recorded
+ */
+uint64_t trace_begin(void);
+
+/**
+ * Records a trace event that lasted from trace_begin() until now
+ * @param name Name of the event, must be a string constant
+ * @param start Value returned by trace_begin()
+ */
+void trace_end(const char *name, uint64_t start);
+
+/**
+ * Records a trace event around a single call, named after the call
+ */
+#define TRACE_CALL(call) do { uint64_t trace_start_time = trace_begin(); call; \
+    trace_end(#call, trace_start_time); } while (0)
+
+/**
+ * Writes the recorded events as a Chrome trace, which can be opened in chrome://tracing or Perfetto
+ * @param filename File to write to
+ * @return Boolean true on success
+ */
+int trace_save(const char *filename);
+
+#endif // GAME_TRACE_H
@@ -1,6 +1,7 @@
 #include "undo.h"
 
 #include "building/industry.h"
+#include "building/list.h"
 #include "building/properties.h"
 #include "building/storage.h"
 #include "building/warehouse.h"
@@ -209,6 +210,8 @@ void game_undo_perform(void)
             if (data.buildings[i].id) {
                 building *b = building_get(data.buildings[i].id);
                 memcpy(b, &data.buildings[i], sizeof(building));
+                building_list_storage_invalidate();
+                map_building_invalidate_houses();
                 if (b->type == BUILDING_WAREHOUSE || b->type == BUILDING_GRANARY) {
                     if (!building_storage_restore(b->storage_id)) {
                         building_storage_reset_building_ids();
@@ -2,18 +2,25 @@
 
 #include "building/type.h"
 #include "city/constants.h"
+#include "city/warning.h"
+#include "core/file.h"
+#include "core/string.h"
+#include "game/perf.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/system.h"
+#include "game/trace.h"
 #include "graphics/screenshot.h"
 #include "graphics/video.h"
 #include "graphics/window.h"
 #include "input/scroll.h"
+#include "translation/translation.h"
 #include "window/hotkey_editor.h"
 #include "window/popup_dialog.h"
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 typedef struct {
     int *action;
@@ -34,6 +41,8 @@ typedef struct {
     int resize_to;
     int save_screenshot;
     int save_city_screenshot;
+    int toggle_performance_hud;
+    int save_performance_trace;
 } global_hotkeys;
 
 static struct {
@@ -183,6 +192,38 @@ static void set_definition_for_action(hotkey_action action, hotkey_definition *d
             def->action = &data.hotkey_state.set_bookmark;
             def->value = 4;
             break;
+        case HOTKEY_QUICKLOAD_1:
+            def->action = &data.hotkey_state.quickload;
+            def->value = 1;
+            break;
+        case HOTKEY_QUICKLOAD_2:
+            def->action = &data.hotkey_state.quickload;
+            def->value = 2;
+            break;
+        case HOTKEY_QUICKLOAD_3:
+            def->action = &data.hotkey_state.quickload;
+            def->value = 3;
+            break;
+        case HOTKEY_QUICKLOAD_4:
+            def->action = &data.hotkey_state.quickload;
+            def->value = 4;
+            break;
+        case HOTKEY_QUICKSAVE_1:
+            def->action = &data.hotkey_state.quicksave;
+            def->value = 1;
+            break;
+        case HOTKEY_QUICKSAVE_2:
+            def->action = &data.hotkey_state.quicksave;
+            def->value = 2;
+            break;
+        case HOTKEY_QUICKSAVE_3:
+            def->action = &data.hotkey_state.quicksave;
+            def->value = 3;
+            break;
+        case HOTKEY_QUICKSAVE_4:
+            def->action = &data.hotkey_state.quicksave;
+            def->value = 4;
+            break;
         case HOTKEY_CENTER_WINDOW:
             def->action = &data.global_hotkey_state.center_screen;
             break;
@@ -207,6 +248,12 @@ static void set_definition_for_action(hotkey_action action, hotkey_definition *d
         case HOTKEY_SAVE_CITY_SCREENSHOT:
             def->action = &data.global_hotkey_state.save_city_screenshot;
             break;
+        case HOTKEY_TOGGLE_PERFORMANCE_HUD:
+            def->action = &data.global_hotkey_state.toggle_performance_hud;
+            break;
+        case HOTKEY_SAVE_PERFORMANCE_TRACE:
+            def->action = &data.global_hotkey_state.save_performance_trace;
+            break;
         case HOTKEY_BUILD_VACANT_HOUSE:
             def->action = &data.hotkey_state.building;
             def->value = BUILDING_HOUSE_VACANT_LOT;
@@ -444,6 +491,27 @@ void hotkey_handle_escape(void)
     window_popup_dialog_show(POPUP_DIALOG_QUIT, confirm_exit, 1);
 }
 
+static void save_performance_trace(void)
+{
+    if (!trace_is_recording()) {
+        if (trace_start()) {
+            city_warning_show_custom(translation_for(TR_WARNING_TRACE_RECORDING));
+        }
+        return;
+    }
+    char filename[FILE_NAME_MAX];
+    time_t curtime = time(NULL);
+    strftime(filename, FILE_NAME_MAX, "trace %Y-%m-%d %H.%M.%S.json", localtime(&curtime));
+    if (trace_save(filename)) {
+        uint8_t notice_text[FILE_NAME_MAX];
+        const uint8_t *prefix = translation_for(TR_WARNING_TRACE_SAVED);
+        string_copy(prefix, notice_text, FILE_NAME_MAX);
+        int prefix_length = string_length(prefix);
+        string_copy(string_from_ascii(filename), &notice_text[prefix_length], FILE_NAME_MAX - prefix_length);
+        city_warning_show_custom(notice_text);
+    }
+}
+
 void hotkey_handle_global_keys(void)
 {
     if (data.global_hotkey_state.center_screen) {
@@ -465,6 +533,12 @@ void hotkey_handle_global_keys(void)
     if (data.global_hotkey_state.save_city_screenshot) {
         graphics_save_screenshot(1);
     }
+    if (data.global_hotkey_state.toggle_performance_hud) {
+        perf_toggle();
+    }
+    if (data.global_hotkey_state.save_performance_trace) {
+        save_performance_trace();
+    }
 }
 
 void hotkey_set_value_for_action(hotkey_action action, int value)
@@ -23,6 +23,8 @@ typedef struct {
     int go_to_bookmark;
     int load_file;
     int save_file;
+    int quickload;
+    int quicksave;
     int building;
     int clone_building;
 } hotkeys;
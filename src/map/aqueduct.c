@@ -1,5 +1,6 @@
 #include "aqueduct.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 
 /**
@@ -64,3 +65,8 @@ void map_aqueduct_load_state(buffer *buf, buffer *backup)
     map_grid_load_state_u8(aqueduct.items, buf);
     map_grid_load_state_u8(aqueduct_backup.items, backup);
 }
+
+uint64_t map_aqueduct_hash_state(void)
+{
+    return hash_xxh64(aqueduct.items, sizeof(aqueduct.items), 0);
+}
@@ -23,4 +23,6 @@ void map_aqueduct_save_state(buffer *buf, buffer *backup);
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup);
 
+uint64_t map_aqueduct_hash_state(void);
+
 #endif // MAP_AQUEDUCT_H
@@ -0,0 +1,88 @@
+#include "area.h"
+
+#include "map/data.h"
+#include "map/grid.h"
+
+void map_area_clear(map_area *area)
+{
+    area->x_min = GRID_SIZE;
+    area->y_min = GRID_SIZE;
+    area->x_max = -1;
+    area->y_max = -1;
+}
+
+void map_area_set_all(map_area *area)
+{
+    area->x_min = 0;
+    area->y_min = 0;
+    area->x_max = GRID_SIZE - 1;
+    area->y_max = GRID_SIZE - 1;
+}
+
+int map_area_is_empty(const map_area *area)
+{
+    return area->x_min > area->x_max;
+}
+
+void map_area_add_tile(map_area *area, int grid_offset)
+{
+    int x = grid_offset % GRID_SIZE;
+    int y = grid_offset / GRID_SIZE;
+    if (x < area->x_min) {
+        area->x_min = x;
+    }
+    if (x > area->x_max) {
+        area->x_max = x;
+    }
+    if (y < area->y_min) {
+        area->y_min = y;
+    }
+    if (y > area->y_max) {
+        area->y_max = y;
+    }
+}
+
+void map_area_add_area(map_area *area, const map_area *other)
+{
+    if (map_area_is_empty(other)) {
+        return;
+    }
+    if (other->x_min < area->x_min) {
+        area->x_min = other->x_min;
+    }
+    if (other->x_max > area->x_max) {
+        area->x_max = other->x_max;
+    }
+    if (other->y_min < area->y_min) {
+        area->y_min = other->y_min;
+    }
+    if (other->y_max > area->y_max) {
+        area->y_max = other->y_max;
+    }
+}
+
+int map_area_get_map_region(const map_area *area, int border, int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    if (map_area_is_empty(area)) {
+        return 0;
+    }
+    int x_start = map_data.start_offset % GRID_SIZE;
+    int y_start = map_data.start_offset / GRID_SIZE;
+    *x_min = area->x_min - x_start - border;
+    *y_min = area->y_min - y_start - border;
+    *x_max = area->x_max - x_start + border;
+    *y_max = area->y_max - y_start + border;
+    if (*x_min < 0) {
+        *x_min = 0;
+    }
+    if (*y_min < 0) {
+        *y_min = 0;
+    }
+    if (*x_max >= map_data.width) {
+        *x_max = map_data.width - 1;
+    }
+    if (*y_max >= map_data.height) {
+        *y_max = map_data.height - 1;
+    }
+    return *x_min <= *x_max && *y_min <= *y_max;
+}
@@ -0,0 +1,35 @@
+#ifndef MAP_AREA_H
+#define MAP_AREA_H
+
+/**
+ * Rectangle of tiles that keeps track of where the map has changed.
+ * Tiles are stored in grid coordinates, including the border around the map,
+ * so that changes outside the playable map can be recorded too.
+ */
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} map_area;
+
+void map_area_clear(map_area *area);
+
+void map_area_set_all(map_area *area);
+
+int map_area_is_empty(const map_area *area);
+
+void map_area_add_tile(map_area *area, int grid_offset);
+
+void map_area_add_area(map_area *area, const map_area *other);
+
+/**
+ * Gets the part of the map covered by the area, in map coordinates
+ * @param area Area to get the map region for
+ * @param border Number of tiles to add around the area
+ * @param x_min, y_min, x_max, y_max Result: region on the map
+ * @return 1 if the area covers any tile on the map, 0 otherwise
+ */
+int map_area_get_map_region(const map_area *area, int border, int *x_min, int *y_min, int *x_max, int *y_max);
+
+#endif // MAP_AREA_H
@@ -1,12 +1,33 @@
 #include "building.h"
 
 #include "building/building.h"
+#include "core/hash.h"
 #include "map/grid.h"
+#include "map/routing_terrain.h"
+#include "map/tiles.h"
 
 static grid_u16 buildings_grid;
 static grid_u8 damage_grid;
 static grid_u8 rubble_type_grid;
 
+static struct {
+    grid_u16 grid;
+    int is_valid;
+} houses;
+
+static int get_house_id(int building_id)
+{
+    return building_id && building_is_house(building_get(building_id)->type) ? building_id : 0;
+}
+
+static void build_houses_grid(void)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        houses.grid.items[i] = get_house_id(buildings_grid.items[i]);
+    }
+    houses.is_valid = 1;
+}
+
 int map_building_at(int grid_offset)
 {
     return map_grid_is_valid_offset(grid_offset) ? buildings_grid.items[grid_offset] : 0;
@@ -14,7 +35,27 @@ int map_building_at(int grid_offset)
 
 void map_building_set(int grid_offset, int building_id)
 {
-    buildings_grid.items[grid_offset] = building_id;
+    if (buildings_grid.items[grid_offset] != building_id) {
+        buildings_grid.items[grid_offset] = building_id;
+        if (houses.is_valid) {
+            houses.grid.items[grid_offset] = get_house_id(building_id);
+        }
+        map_routing_mark_tile_changed(grid_offset);
+        map_tiles_mark_building_changed(grid_offset);
+    }
+}
+
+int map_building_house_at(int grid_offset)
+{
+    if (!houses.is_valid) {
+        build_houses_grid();
+    }
+    return houses.grid.items[grid_offset];
+}
+
+void map_building_invalidate_houses(void)
+{
+    houses.is_valid = 0;
 }
 
 void map_building_damage_clear(int grid_offset)
@@ -42,6 +83,9 @@ void map_building_clear(void)
     map_grid_clear_u16(buildings_grid.items);
     map_grid_clear_u8(damage_grid.items);
     map_grid_clear_u8(rubble_type_grid.items);
+    houses.is_valid = 0;
+    map_routing_mark_all_changed();
+    map_tiles_mark_all_changed();
 }
 
 void map_building_save_state(buffer *buildings, buffer *damage)
@@ -54,6 +98,17 @@ void map_building_load_state(buffer *buildings, buffer *damage)
 {
     map_grid_load_state_u16(buildings_grid.items, buildings);
     map_grid_load_state_u8(damage_grid.items, damage);
+    houses.is_valid = 0;
+    map_routing_mark_all_changed();
+    map_tiles_mark_all_changed();
+}
+
+uint64_t map_building_hash_state(void)
+{
+    uint64_t hash = 0;
+    hash = hash_xxh64(buildings_grid.items, sizeof(buildings_grid.items), hash);
+    hash = hash_xxh64(damage_grid.items, sizeof(damage_grid.items), hash);
+    return hash;
 }
 
 int map_building_is_reservoir(int x, int y)
@@ -13,6 +13,20 @@ int map_building_at(int grid_offset);
 
 void map_building_set(int grid_offset, int building_id);
 
+/**
+ * Returns the house at the given offset, using a separate grid that only contains houses.
+ * The house may be empty, so callers still need to check its population.
+ * @param grid_offset Map offset
+ * @return Building ID of the house at offset, 0 means no house
+ */
+int map_building_house_at(int grid_offset);
+
+/**
+ * Rebuilds the house grid on next use, needs to be called when buildings may have become houses
+ * without being placed on the map again
+ */
+void map_building_invalidate_houses(void);
+
 /**
  * Increases building damage by 1
  * @param grid_offset Map offset
@@ -35,6 +49,8 @@ void map_building_save_state(buffer *buildings, buffer *damage);
 
 void map_building_load_state(buffer *buildings, buffer *damage);
 
+uint64_t map_building_hash_state(void);
+
 int map_building_is_reservoir(int x, int y);
 
 #endif // MAP_BUILDING_H
@@ -3,6 +3,7 @@
 #include "building/building.h"
 #include "building/model.h"
 #include "core/calc.h"
+#include "core/hash.h"
 #include "map/data.h"
 #include "map/grid.h"
 #include "map/property.h"
@@ -159,3 +160,8 @@ void map_desirability_load_state(buffer *buf)
 {
     map_grid_load_state_i8(desirability_grid.items, buf);
 }
+
+uint64_t map_desirability_hash_state(void)
+{
+    return hash_xxh64(desirability_grid.items, sizeof(desirability_grid.items), 0);
+}
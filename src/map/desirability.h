@@ -15,4 +15,6 @@ void map_desirability_save_state(buffer *buf);
 
 void map_desirability_load_state(buffer *buf);
 
+uint64_t map_desirability_hash_state(void);
+
 #endif // MAP_DESIRABILITY_H
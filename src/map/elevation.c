@@ -1,5 +1,6 @@
 #include "elevation.h"
 
+#include "core/hash.h"
 #include "map/data.h"
 #include "map/grid.h"
 
@@ -56,3 +57,8 @@ void map_elevation_load_state(buffer *buf)
 {
     map_grid_load_state_u8(elevation.items, buf);
 }
+
+uint64_t map_elevation_hash_state(void)
+{
+    return hash_xxh64(elevation.items, sizeof(elevation.items), 0);
+}
@@ -15,4 +15,6 @@ void map_elevation_save_state(buffer *buf);
 
 void map_elevation_load_state(buffer *buf);
 
+uint64_t map_elevation_hash_state(void);
+
 #endif // MAP_ELEVATION_H
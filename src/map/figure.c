@@ -1,9 +1,102 @@
 #include "figure.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 
+// Coarse buckets of figures by tile position, for finding figures within a distance
+#define BUCKET_SIZE 8
+#define BUCKETS_PER_ROW ((GRID_SIZE + BUCKET_SIZE - 1) / BUCKET_SIZE)
+#define NUM_BUCKETS (BUCKETS_PER_ROW * BUCKETS_PER_ROW)
+// Figures taken off the map keep their position, but may move without being re-added
+#define BUCKET_OFF_MAP NUM_BUCKETS
+#define NO_BUCKET -1
+
 static grid_u16 figures;
 
+static struct {
+    int is_built;
+    int16_t first[NUM_BUCKETS + 1];
+    int16_t next[MAX_FIGURES];
+    int16_t prev[MAX_FIGURES];
+    int16_t bucket[MAX_FIGURES];
+} buckets;
+
+// Previous figure and tail of the figure list on each tile, so figures can be added and removed directly
+#define NO_TILE -1
+#define MAX_TILE_INDEX 20
+
+static struct {
+    int is_built;
+    int16_t prev[MAX_FIGURES];
+    int16_t offset[MAX_FIGURES];
+    uint16_t last[GRID_SIZE * GRID_SIZE];
+    uint16_t count[GRID_SIZE * GRID_SIZE];
+} tiles;
+
+static int bucket_for(const figure *f)
+{
+    if (f->x >= GRID_SIZE || f->y >= GRID_SIZE) {
+        return BUCKET_OFF_MAP;
+    }
+    return (f->y / BUCKET_SIZE) * BUCKETS_PER_ROW + f->x / BUCKET_SIZE;
+}
+
+static void bucket_remove(int figure_id)
+{
+    int bucket = buckets.bucket[figure_id];
+    if (bucket == NO_BUCKET) {
+        return;
+    }
+    int prev = buckets.prev[figure_id];
+    int next = buckets.next[figure_id];
+    if (prev) {
+        buckets.next[prev] = next;
+    } else {
+        buckets.first[bucket] = next;
+    }
+    if (next) {
+        buckets.prev[next] = prev;
+    }
+    buckets.bucket[figure_id] = NO_BUCKET;
+}
+
+static void bucket_insert(int figure_id, int bucket)
+{
+    buckets.bucket[figure_id] = bucket;
+    buckets.prev[figure_id] = 0;
+    buckets.next[figure_id] = buckets.first[bucket];
+    if (buckets.first[bucket]) {
+        buckets.prev[buckets.first[bucket]] = figure_id;
+    }
+    buckets.first[bucket] = figure_id;
+}
+
+static void bucket_move(figure *f, int bucket)
+{
+    if (!buckets.is_built || f->id <= 0 || f->id >= MAX_FIGURES) {
+        return;
+    }
+    bucket_remove(f->id);
+    bucket_insert(f->id, bucket);
+}
+
+static void build_buckets(void)
+{
+    for (int i = 0; i <= NUM_BUCKETS; i++) {
+        buckets.first[i] = 0;
+    }
+    for (int i = 0; i < MAX_FIGURES; i++) {
+        buckets.bucket[i] = NO_BUCKET;
+    }
+    for (int i = 1; i < MAX_FIGURES; i++) {
+        figure *f = figure_get(i);
+        if (f->state) {
+            bucket_insert(i, bucket_for(f));
+        }
+    }
+    buckets.is_built = 1;
+}
+
 int map_has_figure_at(int grid_offset)
 {
     return map_grid_is_valid_offset(grid_offset) && figures.items[grid_offset] > 0;
@@ -16,16 +109,61 @@ int map_figure_at(int grid_offset)
 
 static void cap_figures_on_same_tile_index(figure *f)
 {
-    if (f->figures_on_same_tile_index > 20) {
-        f->figures_on_same_tile_index = 20;
+    if (f->figures_on_same_tile_index > MAX_TILE_INDEX) {
+        f->figures_on_same_tile_index = MAX_TILE_INDEX;
     }
 }
 
-void map_figure_add(figure *f)
+static void build_tiles(void)
 {
-    if (!map_grid_is_valid_offset(f->grid_offset)) {
-        return;
+    for (int i = 0; i < MAX_FIGURES; i++) {
+        tiles.prev[i] = 0;
+        tiles.offset[i] = NO_TILE;
+    }
+    for (int grid_offset = 0; grid_offset < GRID_SIZE * GRID_SIZE; grid_offset++) {
+        tiles.last[grid_offset] = 0;
+        tiles.count[grid_offset] = 0;
+        int prev_id = 0;
+        int figure_id = figures.items[grid_offset];
+        for (int guard = 0; figure_id > 0 && figure_id < MAX_FIGURES && guard < MAX_FIGURES; guard++) {
+            tiles.prev[figure_id] = prev_id;
+            tiles.offset[figure_id] = grid_offset;
+            tiles.last[grid_offset] = figure_id;
+            tiles.count[grid_offset]++;
+            prev_id = figure_id;
+            figure_id = figure_get(figure_id)->next_figure_id_on_same_tile;
+        }
+    }
+    tiles.is_built = 1;
+}
+
+static int can_add_directly(const figure *f)
+{
+    if (f->id <= 0 || f->id >= MAX_FIGURES || tiles.offset[f->id] != NO_TILE) {
+        return 0;
     }
+    if (!figures.items[f->grid_offset]) {
+        return 1;
+    }
+    int last_id = tiles.last[f->grid_offset];
+    return last_id && tiles.offset[last_id] == f->grid_offset && !figure_get(last_id)->next_figure_id_on_same_tile;
+}
+
+static int can_delete_directly(const figure *f)
+{
+    if (f->id <= 0 || f->id >= MAX_FIGURES || tiles.offset[f->id] != f->grid_offset) {
+        return 0;
+    }
+    int prev_id = tiles.prev[f->id];
+    if (prev_id) {
+        return figure_get(prev_id)->next_figure_id_on_same_tile == f->id;
+    } else {
+        return figures.items[f->grid_offset] == f->id;
+    }
+}
+
+static void add_by_walking(figure *f)
+{
     f->figures_on_same_tile_index = 0;
     f->next_figure_id_on_same_tile = 0;
 
@@ -43,6 +181,51 @@ void map_figure_add(figure *f)
     }
 }
 
+static void delete_by_walking(figure *f)
+{
+    if (figures.items[f->grid_offset] == f->id) {
+        figures.items[f->grid_offset] = f->next_figure_id_on_same_tile;
+    } else {
+        figure *prev = figure_get(figures.items[f->grid_offset]);
+        while (prev->id && prev->next_figure_id_on_same_tile != f->id) {
+            prev = figure_get(prev->next_figure_id_on_same_tile);
+        }
+        prev->next_figure_id_on_same_tile = f->next_figure_id_on_same_tile;
+    }
+    f->next_figure_id_on_same_tile = 0;
+}
+
+void map_figure_add(figure *f)
+{
+    bucket_move(f, bucket_for(f));
+    if (!map_grid_is_valid_offset(f->grid_offset)) {
+        return;
+    }
+    if (!tiles.is_built) {
+        build_tiles();
+    }
+    if (!can_add_directly(f)) {
+        // Figure added twice or lists out of sync: keep the original behaviour and rebuild the lists afterwards
+        add_by_walking(f);
+        tiles.is_built = 0;
+        return;
+    }
+    int grid_offset = f->grid_offset;
+    f->next_figure_id_on_same_tile = 0;
+    f->figures_on_same_tile_index = tiles.count[grid_offset];
+    cap_figures_on_same_tile_index(f);
+    if (figures.items[grid_offset]) {
+        figure_get(tiles.last[grid_offset])->next_figure_id_on_same_tile = f->id;
+        tiles.prev[f->id] = tiles.last[grid_offset];
+    } else {
+        figures.items[grid_offset] = f->id;
+        tiles.prev[f->id] = 0;
+    }
+    tiles.last[grid_offset] = f->id;
+    tiles.count[grid_offset]++;
+    tiles.offset[f->id] = grid_offset;
+}
+
 void map_figure_update(figure *f)
 {
     if (!map_grid_is_valid_offset(f->grid_offset)) {
@@ -50,34 +233,53 @@ void map_figure_update(figure *f)
     }
     f->figures_on_same_tile_index = 0;
 
+    // The index is capped, so there is no need to look further than that
     figure *next = figure_get(figures.items[f->grid_offset]);
-    while (next->id) {
+    while (next->id && f->figures_on_same_tile_index < MAX_TILE_INDEX) {
         if (next->id == f->id) {
-            cap_figures_on_same_tile_index(f);
             return;
         }
         f->figures_on_same_tile_index++;
         next = figure_get(next->next_figure_id_on_same_tile);
     }
-    cap_figures_on_same_tile_index(f);
 }
 
 void map_figure_delete(figure *f)
 {
+    bucket_move(f, BUCKET_OFF_MAP);
     if (!map_grid_is_valid_offset(f->grid_offset) || !figures.items[f->grid_offset]) {
         f->next_figure_id_on_same_tile = 0;
         return;
     }
-
-    if (figures.items[f->grid_offset] == f->id) {
-        figures.items[f->grid_offset] = f->next_figure_id_on_same_tile;
+    if (!tiles.is_built) {
+        build_tiles();
+    }
+    if (f->id > 0 && f->id < MAX_FIGURES && tiles.offset[f->id] == NO_TILE) {
+        // Not on any list: walking the list would end at the unused figure 0
+        figure_get(0)->next_figure_id_on_same_tile = f->next_figure_id_on_same_tile;
+        f->next_figure_id_on_same_tile = 0;
+        return;
+    }
+    if (!can_delete_directly(f)) {
+        delete_by_walking(f);
+        tiles.is_built = 0;
+        return;
+    }
+    int grid_offset = f->grid_offset;
+    int prev_id = tiles.prev[f->id];
+    int next_id = f->next_figure_id_on_same_tile;
+    if (prev_id) {
+        figure_get(prev_id)->next_figure_id_on_same_tile = next_id;
     } else {
-        figure *prev = figure_get(figures.items[f->grid_offset]);
-        while (prev->id && prev->next_figure_id_on_same_tile != f->id) {
-            prev = figure_get(prev->next_figure_id_on_same_tile);
-        }
-        prev->next_figure_id_on_same_tile = f->next_figure_id_on_same_tile;
+        figures.items[grid_offset] = next_id;
     }
+    if (next_id) {
+        tiles.prev[next_id] = prev_id;
+    } else {
+        tiles.last[grid_offset] = prev_id;
+    }
+    tiles.count[grid_offset]--;
+    tiles.offset[f->id] = NO_TILE;
     f->next_figure_id_on_same_tile = 0;
 }
 
@@ -97,9 +299,47 @@ int map_figure_foreach_until(int grid_offset, int (*callback)(figure *f))
     return 0;
 }
 
+static void foreach_in_bucket(int bucket, void (*callback)(figure *f))
+{
+    int figure_id = buckets.first[bucket];
+    while (figure_id) {
+        figure *f = figure_get(figure_id);
+        int next_id = buckets.next[figure_id];
+        if (f->state) {
+            callback(f);
+        } else {
+            // Deleted figure: it will be re-added when the slot is used again
+            bucket_remove(figure_id);
+        }
+        figure_id = next_id;
+    }
+}
+
+void map_figure_foreach_near(int x, int y, int max_distance, void (*callback)(figure *f))
+{
+    if (!buckets.is_built) {
+        build_buckets();
+    }
+    if (max_distance < 0) {
+        max_distance = 0;
+    }
+    int min_x = x - max_distance < 0 ? 0 : (x - max_distance) / BUCKET_SIZE;
+    int min_y = y - max_distance < 0 ? 0 : (y - max_distance) / BUCKET_SIZE;
+    int max_x = x + max_distance >= GRID_SIZE ? BUCKETS_PER_ROW - 1 : (x + max_distance) / BUCKET_SIZE;
+    int max_y = y + max_distance >= GRID_SIZE ? BUCKETS_PER_ROW - 1 : (y + max_distance) / BUCKET_SIZE;
+    for (int bucket_y = min_y; bucket_y <= max_y; bucket_y++) {
+        for (int bucket_x = min_x; bucket_x <= max_x; bucket_x++) {
+            foreach_in_bucket(bucket_y * BUCKETS_PER_ROW + bucket_x, callback);
+        }
+    }
+    foreach_in_bucket(BUCKET_OFF_MAP, callback);
+}
+
 void map_figure_clear(void)
 {
     map_grid_clear_u16(figures.items);
+    buckets.is_built = 0;
+    tiles.is_built = 0;
 }
 
 void map_figure_save_state(buffer *buf)
@@ -110,4 +350,11 @@ void map_figure_save_state(buffer *buf)
 void map_figure_load_state(buffer *buf)
 {
     map_grid_load_state_u16(figures.items, buf);
+    buckets.is_built = 0;
+    tiles.is_built = 0;
+}
+
+uint64_t map_figure_hash_state(void)
+{
+    return hash_xxh64(figures.items, sizeof(figures.items), 0);
 }
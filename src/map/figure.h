@@ -26,6 +26,17 @@ void map_figure_delete(figure *f);
 
 int map_figure_foreach_until(int grid_offset, int (*callback)(figure *f));
 
+/**
+ * Calls the callback for every figure that may be within the given distance of a tile.
+ * Figures further away or dead figures may also be passed, the callback has to check for itself.
+ * The callback must not add, move or delete figures.
+ * @param x X coordinate of the tile
+ * @param y Y coordinate of the tile
+ * @param max_distance Maximum distance in tiles, as calculated by calc_maximum_distance
+ * @param callback Function to call for every figure
+ */
+void map_figure_foreach_near(int x, int y, int max_distance, void (*callback)(figure *f));
+
 /**
  * Clears the map
  */
@@ -35,4 +46,6 @@ void map_figure_save_state(buffer *buf);
 
 void map_figure_load_state(buffer *buf);
 
+uint64_t map_figure_hash_state(void);
+
 #endif // MAP_FIGURE_H
@@ -1,5 +1,6 @@
 #include "image.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 
 static grid_u16 images;
@@ -59,3 +60,8 @@ void map_image_load_state(buffer *buf)
 {
     map_grid_load_state_u16(images.items, buf);
 }
+
+uint64_t map_image_hash_state(void)
+{
+    return hash_xxh64(images.items, sizeof(images.items), 0);
+}
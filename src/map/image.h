@@ -20,4 +20,6 @@ void map_image_save_state(buffer *buf);
 
 void map_image_load_state(buffer *buf);
 
+uint64_t map_image_hash_state(void);
+
 #endif // MAP_IMAGE_H
@@ -9,6 +9,9 @@
 #include "map/terrain.h"
 
 #define MAX_TILES 8
+#define MAX_PATTERNS 256
+#define PATTERN_NOT_CACHED 0
+#define PATTERN_NO_MATCH 0xff
 
 struct terrain_image_context {
     const unsigned char tiles[MAX_TILES];
@@ -290,6 +293,9 @@ static struct {
     {terrain_images_aqueduct, 16}
 };
 
+// For each combination of surrounding tiles: the index of the first matching context plus one
+static unsigned char pattern_cache[CONTEXT_MAX_ITEMS][MAX_PATTERNS];
+
 static void clear_current_offset(struct terrain_image_context *items, int num_items)
 {
     for (int i = 0; i < num_items; i++) {
@@ -324,29 +330,71 @@ static int context_matches_tiles(const struct terrain_image_context *context, co
     return 1;
 }
 
-static const terrain_image *get_image(int group, int tiles[MAX_TILES])
+static int get_pattern(const int tiles[MAX_TILES])
 {
-    static terrain_image result;
+    int pattern = 0;
+    for (int i = 0; i < MAX_TILES; i++) {
+        pattern |= tiles[i] << i;
+    }
+    return pattern;
+}
 
-    result.is_valid = 0;
-    struct terrain_image_context *context = context_pointers[group].context;
+static int lookup_context(int group, const int tiles[MAX_TILES])
+{
+    const struct terrain_image_context *context = context_pointers[group].context;
     int size = context_pointers[group].size;
     for (int i = 0; i < size; i++) {
         if (context_matches_tiles(&context[i], tiles)) {
-            context[i].current_item_offset++;
-            if (context[i].current_item_offset >= context[i].max_item_offset) {
-                context[i].current_item_offset = 0;
-            }
-            result.is_valid = 1;
-            result.group_offset = context[i].offset_for_orientation[city_view_orientation() / 2];
-            result.item_offset = context[i].current_item_offset;
-            result.aqueduct_offset = context[i].aqueduct_offset;
-            break;
+            return i;
         }
     }
+    return -1;
+}
+
+static int find_context(int group, int tiles[MAX_TILES])
+{
+    unsigned char *cached = &pattern_cache[group][get_pattern(tiles)];
+    if (*cached == PATTERN_NOT_CACHED) {
+        int index = lookup_context(group, tiles);
+        *cached = index >= 0 ? index + 1 : PATTERN_NO_MATCH;
+    }
+    return *cached == PATTERN_NO_MATCH ? -1 : *cached - 1;
+}
+
+// Same as find_context, but does not touch the cache so that it can be called from several threads
+static int find_context_readonly(int group, int tiles[MAX_TILES])
+{
+    unsigned char cached = pattern_cache[group][get_pattern(tiles)];
+    if (cached == PATTERN_NOT_CACHED) {
+        return lookup_context(group, tiles);
+    }
+    return cached == PATTERN_NO_MATCH ? -1 : cached - 1;
+}
+
+static const terrain_image *get_image_for_context(int group, int index)
+{
+    static terrain_image result;
+
+    result.is_valid = 0;
+    if (index >= 0) {
+        struct terrain_image_context *context = &context_pointers[group].context[index];
+        context->current_item_offset++;
+        if (context->current_item_offset >= context->max_item_offset) {
+            context->current_item_offset = 0;
+        }
+        result.is_valid = 1;
+        result.group_offset = context->offset_for_orientation[city_view_orientation() / 2];
+        result.item_offset = context->current_item_offset;
+        result.aqueduct_offset = context->aqueduct_offset;
+    }
     return &result;
 }
 
+static const terrain_image *get_image(int group, int tiles[MAX_TILES])
+{
+    return get_image_for_context(group, find_context(group, tiles));
+}
+
 const terrain_image *map_image_context_get_elevation(int grid_offset, int elevation)
 {
     int tiles[MAX_TILES];
@@ -381,6 +429,18 @@ const terrain_image *map_image_context_get_shore(int grid_offset)
     return get_image(CONTEXT_WATER, tiles);
 }
 
+int map_image_context_find_shore(int grid_offset)
+{
+    int tiles[MAX_TILES];
+    fill_matches(grid_offset, TERRAIN_WATER, 0, 1, tiles);
+    return find_context_readonly(CONTEXT_WATER, tiles);
+}
+
+const terrain_image *map_image_context_get_shore_for_context(int context)
+{
+    return get_image_for_context(CONTEXT_WATER, context);
+}
+
 const terrain_image *map_image_context_get_wall(int grid_offset)
 {
     int tiles[MAX_TILES];
@@ -15,6 +15,21 @@ void map_image_context_reset_elevation(void);
 const terrain_image *map_image_context_get_elevation(int grid_offset, int elevation);
 const terrain_image *map_image_context_get_earthquake(int grid_offset);
 const terrain_image *map_image_context_get_shore(int grid_offset);
+
+/**
+ * Finds the shore context for a tile without changing any state, so it is safe to call from several threads
+ * @param grid_offset Tile to check
+ * @return Context to pass to map_image_context_get_shore_for_context(), or -1 if no context matches
+ */
+int map_image_context_find_shore(int grid_offset);
+
+/**
+ * Gets the shore image for a context found by map_image_context_find_shore().
+ * Gives the same result as map_image_context_get_shore() for the same tile.
+ * @param context Shore context
+ * @return Image for the context
+ */
+const terrain_image *map_image_context_get_shore_for_context(int context);
 const terrain_image *map_image_context_get_wall(int grid_offset);
 const terrain_image *map_image_context_get_wall_gatehouse(int grid_offset);
 const terrain_image *map_image_context_get_dirt_road(int grid_offset);
@@ -1,5 +1,6 @@
 #include "property.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 #include "map/random.h"
 
@@ -224,3 +225,11 @@ void map_property_load_state(buffer *bitfields, buffer *edge)
     map_grid_load_state_u8(bitfields_grid.items, bitfields);
     map_grid_load_state_u8(edge_grid.items, edge);
 }
+
+uint64_t map_property_hash_state(void)
+{
+    uint64_t hash = 0;
+    hash = hash_xxh64(bitfields_grid.items, sizeof(bitfields_grid.items), hash);
+    hash = hash_xxh64(edge_grid.items, sizeof(edge_grid.items), hash);
+    return hash;
+}
@@ -58,4 +58,6 @@ void map_property_restore(void);
 void map_property_save_state(buffer *bitfields, buffer *edge);
 void map_property_load_state(buffer *bitfields, buffer *edge);
 
+uint64_t map_property_hash_state(void);
+
 #endif // MAP_PROPERTY_H
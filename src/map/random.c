@@ -1,5 +1,6 @@
 #include "random.h"
 
+#include "core/hash.h"
 #include "core/random.h"
 #include "map/grid.h"
 
@@ -35,3 +36,8 @@ void map_random_load_state(buffer *buf)
 {
     map_grid_load_state_u8(random.items, buf);
 }
+
+uint64_t map_random_hash_state(void)
+{
+    return hash_xxh64(random.items, sizeof(random.items), 0);
+}
@@ -13,4 +13,6 @@ void map_random_save_state(buffer *buf);
 
 void map_random_load_state(buffer *buf);
 
+uint64_t map_random_hash_state(void);
+
 #endif // MAP_RANDOM_H
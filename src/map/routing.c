@@ -1,6 +1,8 @@
 #include "routing.h"
 
 #include "building/building.h"
+#include "core/hash.h"
+#include "game/trace.h"
 #include "map/building.h"
 #include "map/figure.h"
 #include "map/grid.h"
@@ -8,6 +10,8 @@
 #include "map/routing_data.h"
 #include "map/terrain.h"
 
+#include <string.h>
+
 #define MAX_QUEUE GRID_SIZE * GRID_SIZE
 #define GUARD 50000
 
@@ -23,6 +27,11 @@ static struct {
     int enemy_routes_calculated;
 } stats = {0, 0};
 
+static struct {
+    routing_statistics data;
+    routing_type current_type;
+} statistics;
+
 static struct {
     int head;
     int tail;
@@ -35,6 +44,17 @@ static struct {
     int through_building_id;
 } state;
 
+static void start_route(routing_type type)
+{
+    statistics.current_type = type;
+    statistics.data.routes[type]++;
+}
+
+static void tile_expanded(void)
+{
+    statistics.data.tiles_expanded[statistics.current_type]++;
+}
+
 static void clear_distances(void)
 {
     map_grid_clear_i16(routing_distance.items);
@@ -64,6 +84,7 @@ static void route_queue(int source, int dest, void (*callback)(int next_offset,
         if (offset == dest) {
             break;
         }
+        tile_expanded();
         int dist = 1 + routing_distance.items[offset];
         for (int i = 0; i < 4; i++) {
             if (valid_offset(offset + ROUTE_OFFSETS[i])) {
@@ -83,6 +104,7 @@ static void route_queue_until(int source, int (*callback)(int next_offset, int d
     enqueue(source, 1);
     while (queue.head != queue.tail) {
         int offset = queue.items[queue.head];
+        tile_expanded();
         int dist = 1 + routing_distance.items[offset];
         for (int i = 0; i < 4; i++) {
             if (valid_offset(offset + ROUTE_OFFSETS[i])) {
@@ -106,7 +128,11 @@ static void route_queue_max(int source, int dest, int max_tiles, void (*callback
     while (queue.head != queue.tail) {
         int offset = queue.items[queue.head];
         if (offset == dest) break;
-        if (++tiles > max_tiles) break;
+        if (++tiles > max_tiles) {
+            statistics.data.guard_hits++;
+            break;
+        }
+        tile_expanded();
         int dist = 1 + routing_distance.items[offset];
         for (int i = 0; i < 4; i++) {
             if (valid_offset(offset + ROUTE_OFFSETS[i])) {
@@ -129,8 +155,10 @@ static void route_queue_boat(int source, void (*callback)(int, int))
     while (queue.head != queue.tail) {
         int offset = queue.items[queue.head];
         if (++tiles > GUARD) {
+            statistics.data.guard_hits++;
             break;
         }
+        tile_expanded();
         int drag = terrain_water.items[offset] == WATER_N2_MAP_EDGE ? 4 : 0;
         if (drag && water_drag.items[offset]++ < drag) {
             queue.items[queue.tail++] = offset;
@@ -159,8 +187,10 @@ static void route_queue_dir8(int source, void (*callback)(int, int))
     int tiles = 0;
     while (queue.head != queue.tail) {
         if (++tiles > GUARD) {
+            statistics.data.guard_hits++;
             break;
         }
+        tile_expanded();
         int offset = queue.items[queue.head];
         int dist = 1 + routing_distance.items[offset];
         for (int i = 0; i < 8; i++) {
@@ -184,7 +214,10 @@ static void callback_calc_distance(int next_offset, int dist)
 void map_routing_calculate_distances(int x, int y)
 {
     ++stats.total_routes_calculated;
+    uint64_t trace_start_time = trace_begin();
+    start_route(ROUTING_TYPE_CITIZEN_DISTANCES);
     route_queue(map_grid_offset(x, y), -1, callback_calc_distance);
+    trace_end("map_routing_calculate_distances", trace_start_time);
 }
 
 static void callback_calc_distance_water_boat(int next_offset, int dist)
@@ -204,6 +237,7 @@ void map_routing_calculate_distances_water_boat(int x, int y)
     if (terrain_water.items[grid_offset] == WATER_N1_BLOCKED) {
         clear_distances();
     } else {
+        start_route(ROUTING_TYPE_WATER_BOAT);
         route_queue_boat(grid_offset, callback_calc_distance_water_boat);
     }
 }
@@ -221,6 +255,7 @@ void map_routing_calculate_distances_water_flotsam(int x, int y)
     if (terrain_water.items[grid_offset] == WATER_N1_BLOCKED) {
         clear_distances();
     } else {
+        start_route(ROUTING_TYPE_WATER_FLOTSAM);
         route_queue_dir8(grid_offset, callback_calc_distance_water_flotsam);
     }
 }
@@ -320,6 +355,7 @@ static int map_can_place_initial_road_or_aqueduct(int grid_offset, int is_aquedu
 int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
 {
     if (type == ROUTED_BUILDING_WALL) {
+        start_route(ROUTING_TYPE_BUILDING);
         route_queue(map_grid_offset(x, y), -1, callback_calc_distance_build_wall);
         return 1;
     }
@@ -333,6 +369,7 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
         return 0;
     }
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_BUILDING);
     if (type == ROUTED_BUILDING_ROAD) {
         route_queue(source_offset, -1, callback_calc_distance_build_road);
     } else {
@@ -357,6 +394,7 @@ static int callback_delete_wall_aqueduct(int next_offset, int dist)
 void map_routing_delete_first_wall_or_aqueduct(int x, int y)
 {
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_DELETE_WALL_AQUEDUCT);
     route_queue_until(map_grid_offset(x, y), callback_delete_wall_aqueduct);
 }
 
@@ -392,6 +430,7 @@ int map_routing_citizen_can_travel_over_land(int src_x, int src_y, int dst_x, in
     int src_offset = map_grid_offset(src_x, src_y);
     int dst_offset = map_grid_offset(dst_x, dst_y);
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_CITIZEN_LAND);
     route_queue(src_offset, dst_offset, callback_travel_citizen_land);
     return routing_distance.items[dst_offset] != 0;
 }
@@ -409,6 +448,7 @@ int map_routing_citizen_can_travel_over_road_garden(int src_x, int src_y, int ds
     int src_offset = map_grid_offset(src_x, src_y);
     int dst_offset = map_grid_offset(dst_x, dst_y);
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_CITIZEN_ROAD_GARDEN);
     route_queue(src_offset, dst_offset, callback_travel_citizen_road_garden);
     return routing_distance.items[dst_offset] != 0;
 }
@@ -426,6 +466,7 @@ int map_routing_can_travel_over_walls(int src_x, int src_y, int dst_x, int dst_y
     int src_offset = map_grid_offset(src_x, src_y);
     int dst_offset = map_grid_offset(dst_x, dst_y);
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_WALLS);
     route_queue(src_offset, dst_offset, callback_travel_walls);
     return routing_distance.items[dst_offset] != 0;
 }
@@ -459,6 +500,7 @@ int map_routing_noncitizen_can_travel_over_land(
     int dst_offset = map_grid_offset(dst_x, dst_y);
     ++stats.total_routes_calculated;
     ++stats.enemy_routes_calculated;
+    start_route(ROUTING_TYPE_NONCITIZEN_LAND);
     if (only_through_building_id) {
         state.through_building_id = only_through_building_id;
         route_queue(src_offset, dst_offset, callback_travel_noncitizen_land_through_building);
@@ -480,6 +522,7 @@ int map_routing_noncitizen_can_travel_through_everything(int src_x, int src_y, i
     int src_offset = map_grid_offset(src_x, src_y);
     int dst_offset = map_grid_offset(dst_x, dst_y);
     ++stats.total_routes_calculated;
+    start_route(ROUTING_TYPE_NONCITIZEN_THROUGH_EVERYTHING);
     route_queue(src_offset, dst_offset, callback_travel_noncitizen_through_everything);
     return routing_distance.items[dst_offset] != 0;
 }
@@ -501,6 +544,16 @@ int map_routing_distance(int grid_offset)
     return routing_distance.items[grid_offset];
 }
 
+const routing_statistics *map_routing_get_statistics(void)
+{
+    return &statistics.data;
+}
+
+void map_routing_reset_statistics(void)
+{
+    memset(&statistics.data, 0, sizeof(statistics.data));
+}
+
 void map_routing_save_state(buffer *buf)
 {
     buffer_write_i32(buf, 0); // unused counter
@@ -516,3 +569,13 @@ void map_routing_load_state(buffer *buf)
     stats.total_routes_calculated = buffer_read_i32(buf);
     buffer_skip(buf, 4); // unused counter
 }
+
+uint64_t map_routing_hash_state(void)
+{
+    uint64_t hash = 0;
+    hash = hash_xxh64(terrain_land_citizen.items, sizeof(terrain_land_citizen.items), hash);
+    hash = hash_xxh64(terrain_land_noncitizen.items, sizeof(terrain_land_noncitizen.items), hash);
+    hash = hash_xxh64(terrain_water.items, sizeof(terrain_water.items), hash);
+    hash = hash_xxh64(terrain_walls.items, sizeof(terrain_walls.items), hash);
+    return hash;
+}
@@ -10,6 +10,26 @@ typedef enum {
     ROUTED_BUILDING_AQUEDUCT_WITHOUT_GRAPHIC = 4,
 } routed_building_type;
 
+typedef enum {
+    ROUTING_TYPE_CITIZEN_DISTANCES = 0,
+    ROUTING_TYPE_WATER_BOAT = 1,
+    ROUTING_TYPE_WATER_FLOTSAM = 2,
+    ROUTING_TYPE_BUILDING = 3,
+    ROUTING_TYPE_DELETE_WALL_AQUEDUCT = 4,
+    ROUTING_TYPE_CITIZEN_LAND = 5,
+    ROUTING_TYPE_CITIZEN_ROAD_GARDEN = 6,
+    ROUTING_TYPE_WALLS = 7,
+    ROUTING_TYPE_NONCITIZEN_LAND = 8,
+    ROUTING_TYPE_NONCITIZEN_THROUGH_EVERYTHING = 9,
+    ROUTING_TYPE_MAX = 10
+} routing_type;
+
+typedef struct {
+    uint64_t routes[ROUTING_TYPE_MAX];
+    uint64_t tiles_expanded[ROUTING_TYPE_MAX];
+    uint64_t guard_hits; // searches stopped by the tile guard or the tile limit
+} routing_statistics;
+
 void map_routing_calculate_distances(int x, int y);
 void map_routing_calculate_distances_water_boat(int x, int y);
 void map_routing_calculate_distances_water_flotsam(int x, int y);
@@ -30,8 +50,14 @@ int map_routing_noncitizen_can_travel_through_everything(int src_x, int src_y, i
 
 void map_routing_block(int x, int y, int size);
 
+const routing_statistics *map_routing_get_statistics(void);
+
+void map_routing_reset_statistics(void);
+
 void map_routing_save_state(buffer *buf);
 
 void map_routing_load_state(buffer *buf);
 
+uint64_t map_routing_hash_state(void);
+
 #endif // MAP_ROUTING_H
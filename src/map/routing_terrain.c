@@ -4,6 +4,7 @@
 #include "city/view.h"
 #include "core/direction.h"
 #include "core/image.h"
+#include "map/area.h"
 #include "map/building.h"
 #include "map/data.h"
 #include "map/image.h"
@@ -13,8 +14,104 @@
 #include "map/sprite.h"
 #include "map/terrain.h"
 
+#ifdef VERIFY_ROUTING
+#include "core/log.h"
+
+#include <string.h>
+#endif
+
+enum {
+    ROUTING_LAND_CITIZEN = 0,
+    ROUTING_LAND_NONCITIZEN = 1,
+    ROUTING_WATER = 2,
+    ROUTING_WALLS = 3,
+    MAX_ROUTING_GRIDS = 4
+};
+
+static struct {
+    map_area changed;
+    map_area pending[MAX_ROUTING_GRIDS];
+    int orientation;
+} dirty = {
+    { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+    {
+        { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+        { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+        { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+        { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 }
+    },
+    0
+};
+
 static void map_routing_update_land_noncitizen(void);
 
+void map_routing_mark_tile_changed(int grid_offset)
+{
+    map_area_add_tile(&dirty.changed, grid_offset);
+}
+
+void map_routing_mark_all_changed(void)
+{
+    map_area_set_all(&dirty.changed);
+}
+
+static void collect_changes(void)
+{
+    // Rotating the city changes the wall, aqueduct and bridge orientation of every tile
+    if (dirty.orientation != city_view_orientation()) {
+        dirty.orientation = city_view_orientation();
+        map_routing_mark_all_changed();
+    }
+    if (map_area_is_empty(&dirty.changed)) {
+        return;
+    }
+    for (int i = 0; i < MAX_ROUTING_GRIDS; i++) {
+        map_area_add_area(&dirty.pending[i], &dirty.changed);
+    }
+    map_area_clear(&dirty.changed);
+}
+
+static void update_grid(int type, grid_i8 *grid, void (*update_tile)(int grid_offset, int x, int y))
+{
+    collect_changes();
+    // A tile depends on its direct neighbours, so include a border of one tile around the changes
+    int x_min, y_min, x_max, y_max;
+    int has_changes = map_area_get_map_region(&dirty.pending[type], 1, &x_min, &y_min, &x_max, &y_max);
+    map_area_clear(&dirty.pending[type]);
+    if (has_changes) {
+        if (x_min == 0 && y_min == 0 && x_max == map_data.width - 1 && y_max == map_data.height - 1) {
+            map_grid_init_i8(grid->items, -1);
+        }
+        for (int y = y_min; y <= y_max; y++) {
+            int grid_offset = map_grid_offset(x_min, y);
+            for (int x = x_min; x <= x_max; x++, grid_offset++) {
+                update_tile(grid_offset, x, y);
+            }
+        }
+    }
+#ifdef VERIFY_ROUTING
+    static grid_i8 updated;
+    memcpy(updated.items, grid->items, sizeof(updated.items));
+    map_grid_init_i8(grid->items, -1);
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            update_tile(grid_offset, x, y);
+        }
+    }
+    int differences = 0;
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (updated.items[i] != grid->items[i]) {
+            differences++;
+        }
+    }
+    if (differences) {
+        static const char *names[MAX_ROUTING_GRIDS] = { "land citizen", "land noncitizen", "water", "walls" };
+        log_error("Routing grid differs from full update, tiles:", names[type], differences);
+    }
+#endif
+}
+
 void map_routing_update_all(void)
 {
     map_routing_update_land();
@@ -106,39 +203,39 @@ static int get_land_type_citizen_aqueduct(int grid_offset)
     }
 }
 
-void map_routing_update_land_citizen(void)
+static void update_land_citizen_tile(int grid_offset, int x, int y)
 {
-    map_grid_init_i8(terrain_land_citizen.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            int terrain = map_terrain_get(grid_offset);
-            if (terrain & TERRAIN_ROAD) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_0_ROAD;
-            } else if (terrain & (TERRAIN_RUBBLE | TERRAIN_ACCESS_RAMP | TERRAIN_GARDEN)) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_2_PASSABLE_TERRAIN;
-            } else if (terrain & (TERRAIN_BUILDING | TERRAIN_GATEHOUSE)) {
-                if (!map_building_at(grid_offset)) {
-                    // shouldn't happen
-                    terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
-                    map_terrain_remove(grid_offset, TERRAIN_BUILDING);
-                    map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
-                    map_property_mark_draw_tile(grid_offset);
-                    map_property_set_multi_tile_size(grid_offset, 1);
-                    continue;
-                }
-                terrain_land_citizen.items[grid_offset] = get_land_type_citizen_building(grid_offset);
-            } else if (terrain & TERRAIN_AQUEDUCT) {
-                terrain_land_citizen.items[grid_offset] = get_land_type_citizen_aqueduct(grid_offset);
-            } else if (terrain & TERRAIN_NOT_CLEAR) {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_N1_BLOCKED;
-            } else {
-                terrain_land_citizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN;
-            }
+    int terrain = map_terrain_get(grid_offset);
+    if (terrain & TERRAIN_ROAD) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_0_ROAD;
+    } else if (terrain & (TERRAIN_RUBBLE | TERRAIN_ACCESS_RAMP | TERRAIN_GARDEN)) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_2_PASSABLE_TERRAIN;
+    } else if (terrain & (TERRAIN_BUILDING | TERRAIN_GATEHOUSE)) {
+        if (!map_building_at(grid_offset)) {
+            // shouldn't happen
+            terrain_land_citizen.items[grid_offset] = -1;
+            terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
+            map_terrain_remove(grid_offset, TERRAIN_BUILDING);
+            map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
+            map_property_mark_draw_tile(grid_offset);
+            map_property_set_multi_tile_size(grid_offset, 1);
+            return;
         }
+        terrain_land_citizen.items[grid_offset] = get_land_type_citizen_building(grid_offset);
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        terrain_land_citizen.items[grid_offset] = get_land_type_citizen_aqueduct(grid_offset);
+    } else if (terrain & TERRAIN_NOT_CLEAR) {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_N1_BLOCKED;
+    } else {
+        terrain_land_citizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN;
     }
 }
 
+void map_routing_update_land_citizen(void)
+{
+    update_grid(ROUTING_LAND_CITIZEN, &terrain_land_citizen, update_land_citizen_tile);
+}
+
 static int get_land_type_noncitizen(int grid_offset)
 {
     int type = NONCITIZEN_1_BUILDING;
@@ -171,34 +268,33 @@ static int get_land_type_noncitizen(int grid_offset)
     return type;
 }
 
-static void map_routing_update_land_noncitizen(void)
+static void update_land_noncitizen_tile(int grid_offset, int x, int y)
 {
-    map_grid_init_i8(terrain_land_noncitizen.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            int terrain = map_terrain_get(grid_offset);
-            if (terrain & TERRAIN_GATEHOUSE) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_4_GATEHOUSE;
-            } else if (terrain & TERRAIN_ROAD) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
-            } else if (terrain & (TERRAIN_GARDEN | TERRAIN_ACCESS_RAMP | TERRAIN_RUBBLE)) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
-            } else if (terrain & TERRAIN_BUILDING) {
-                terrain_land_noncitizen.items[grid_offset] = get_land_type_noncitizen(grid_offset);
-            } else if (terrain & TERRAIN_AQUEDUCT) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
-            } else if (terrain & TERRAIN_WALL) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_3_WALL;
-            } else if (terrain & TERRAIN_NOT_CLEAR) {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_N1_BLOCKED;
-            } else {
-                terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
-            }
-        }
+    int terrain = map_terrain_get(grid_offset);
+    if (terrain & TERRAIN_GATEHOUSE) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_4_GATEHOUSE;
+    } else if (terrain & TERRAIN_ROAD) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
+    } else if (terrain & (TERRAIN_GARDEN | TERRAIN_ACCESS_RAMP | TERRAIN_RUBBLE)) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
+    } else if (terrain & TERRAIN_BUILDING) {
+        terrain_land_noncitizen.items[grid_offset] = get_land_type_noncitizen(grid_offset);
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_2_CLEARABLE;
+    } else if (terrain & TERRAIN_WALL) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_3_WALL;
+    } else if (terrain & TERRAIN_NOT_CLEAR) {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_N1_BLOCKED;
+    } else {
+        terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_0_PASSABLE;
     }
 }
 
+static void map_routing_update_land_noncitizen(void)
+{
+    update_grid(ROUTING_LAND_NONCITIZEN, &terrain_land_noncitizen, update_land_noncitizen_tile);
+}
+
 static int is_surrounded_by_water(int grid_offset)
 {
     return map_terrain_is(grid_offset + map_grid_delta(0, -1), TERRAIN_WATER) &&
@@ -207,37 +303,36 @@ static int is_surrounded_by_water(int grid_offset)
         map_terrain_is(grid_offset + map_grid_delta(0, 1), TERRAIN_WATER);
 }
 
-void map_routing_update_water(void)
+static void update_water_tile(int grid_offset, int x, int y)
 {
-    map_grid_init_i8(terrain_water.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            if (map_terrain_is(grid_offset, TERRAIN_WATER) && is_surrounded_by_water(grid_offset)) {
-                if (x > 0 && x < map_data.width - 1 &&
-                    y > 0 && y < map_data.height - 1) {
-                    switch (map_sprite_bridge_at(grid_offset)) {
-                        case 5:
-                        case 6: // low bridge middle section
-                            terrain_water.items[grid_offset] = WATER_N3_LOW_BRIDGE;
-                            break;
-                        case 13: // ship bridge pillar
-                            terrain_water.items[grid_offset] = WATER_N1_BLOCKED;
-                            break;
-                        default:
-                            terrain_water.items[grid_offset] = WATER_0_PASSABLE;
-                            break;
-                    }
-                } else {
-                    terrain_water.items[grid_offset] = WATER_N2_MAP_EDGE;
-                }
-            } else {
-                terrain_water.items[grid_offset] = WATER_N1_BLOCKED;
+    if (map_terrain_is(grid_offset, TERRAIN_WATER) && is_surrounded_by_water(grid_offset)) {
+        if (x > 0 && x < map_data.width - 1 &&
+            y > 0 && y < map_data.height - 1) {
+            switch (map_sprite_bridge_at(grid_offset)) {
+                case 5:
+                case 6: // low bridge middle section
+                    terrain_water.items[grid_offset] = WATER_N3_LOW_BRIDGE;
+                    break;
+                case 13: // ship bridge pillar
+                    terrain_water.items[grid_offset] = WATER_N1_BLOCKED;
+                    break;
+                default:
+                    terrain_water.items[grid_offset] = WATER_0_PASSABLE;
+                    break;
             }
+        } else {
+            terrain_water.items[grid_offset] = WATER_N2_MAP_EDGE;
         }
+    } else {
+        terrain_water.items[grid_offset] = WATER_N1_BLOCKED;
     }
 }
 
+void map_routing_update_water(void)
+{
+    update_grid(ROUTING_WATER, &terrain_water, update_water_tile);
+}
+
 static int is_wall_tile(int grid_offset)
 {
     return map_terrain_is(grid_offset, TERRAIN_WALL_OR_GATEHOUSE) ? 1 : 0;
@@ -271,27 +366,26 @@ static int count_adjacent_wall_tiles(int grid_offset)
     return adjacent;
 }
 
-void map_routing_update_walls(void)
+static void update_walls_tile(int grid_offset, int x, int y)
 {
-    map_grid_init_i8(terrain_walls.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
-            if (map_terrain_is(grid_offset, TERRAIN_WALL)) {
-                if (count_adjacent_wall_tiles(grid_offset) == 3) {
-                    terrain_walls.items[grid_offset] = WALL_0_PASSABLE;
-                } else {
-                    terrain_walls.items[grid_offset] = WALL_N1_BLOCKED;
-                }
-            } else if (map_terrain_is(grid_offset, TERRAIN_GATEHOUSE)) {
-                terrain_walls.items[grid_offset] = WALL_0_PASSABLE;
-            } else {
-                terrain_walls.items[grid_offset] = WALL_N1_BLOCKED;
-            }
+    if (map_terrain_is(grid_offset, TERRAIN_WALL)) {
+        if (count_adjacent_wall_tiles(grid_offset) == 3) {
+            terrain_walls.items[grid_offset] = WALL_0_PASSABLE;
+        } else {
+            terrain_walls.items[grid_offset] = WALL_N1_BLOCKED;
         }
+    } else if (map_terrain_is(grid_offset, TERRAIN_GATEHOUSE)) {
+        terrain_walls.items[grid_offset] = WALL_0_PASSABLE;
+    } else {
+        terrain_walls.items[grid_offset] = WALL_N1_BLOCKED;
     }
 }
 
+void map_routing_update_walls(void)
+{
+    update_grid(ROUTING_WALLS, &terrain_walls, update_walls_tile);
+}
+
 int map_routing_is_wall_passable(int grid_offset)
 {
     return terrain_walls.items[grid_offset] == WALL_0_PASSABLE;
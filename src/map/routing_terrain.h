@@ -1,6 +1,18 @@
 #ifndef MAP_ROUTING_TERRAIN_H
 #define MAP_ROUTING_TERRAIN_H
 
+/**
+ * Marks a tile whose terrain or building has changed. The routing grids are only recalculated
+ * around changed tiles, so every change that affects routing needs to be reported here.
+ * @param grid_offset Offset of the changed tile
+ */
+void map_routing_mark_tile_changed(int grid_offset);
+
+/**
+ * Marks the whole map as changed, for example after loading a game
+ */
+void map_routing_mark_all_changed(void);
+
 void map_routing_update_all(void);
 void map_routing_update_land(void);
 void map_routing_update_land_citizen(void);
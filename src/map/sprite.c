@@ -1,5 +1,6 @@
 #include "sprite.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 
 static grid_u8 sprite;
@@ -56,3 +57,8 @@ void map_sprite_load_state(buffer *buf, buffer *backup)
     map_grid_load_state_u8(sprite.items, buf);
     map_grid_load_state_u8(sprite_backup.items, backup);
 }
+
+uint64_t map_sprite_hash_state(void)
+{
+    return hash_xxh64(sprite.items, sizeof(sprite.items), 0);
+}
@@ -31,4 +31,6 @@ void map_sprite_save_state(buffer *buf, buffer *backup);
 
 void map_sprite_load_state(buffer *buf, buffer *backup);
 
+uint64_t map_sprite_hash_state(void);
+
 #endif // MAP_SPRITE_H
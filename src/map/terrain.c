@@ -1,12 +1,44 @@
 #include "terrain.h"
 
+#include "core/hash.h"
 #include "map/grid.h"
 #include "map/ring.h"
 #include "map/routing.h"
+#include "map/routing_terrain.h"
+#include "map/tiles.h"
+
+#define NUM_TERRAIN_BITS 16
+
+// The reservoir and fountain ranges and meadows do not affect routing or wall images
+#define TERRAIN_TRACKED (TERRAIN_ALL & ~(TERRAIN_RESERVOIR_RANGE | TERRAIN_FOUNTAIN_RANGE | TERRAIN_MEADOW))
 
 static grid_u16 terrain_grid;
 static grid_u16 terrain_grid_backup;
 
+static struct {
+    unsigned int counts[NUM_TERRAIN_BITS];
+    int pending;
+} changes;
+
+static void record_change(int changed_terrain)
+{
+    // Only remember which types changed, the counters are updated when asked for
+    changes.pending |= changed_terrain;
+    if (changed_terrain & TERRAIN_TRACKED) {
+        map_routing_mark_all_changed();
+        map_tiles_mark_all_changed();
+    }
+}
+
+static void record_tile_change(int grid_offset, int changed_terrain)
+{
+    changes.pending |= changed_terrain;
+    if (changed_terrain & TERRAIN_TRACKED) {
+        map_routing_mark_tile_changed(grid_offset);
+        map_tiles_mark_terrain_changed(grid_offset, changed_terrain);
+    }
+}
+
 int map_terrain_is(int grid_offset, int terrain)
 {
     return map_grid_is_valid_offset(grid_offset) && terrain_grid.items[grid_offset] & terrain;
@@ -19,16 +51,19 @@ int map_terrain_get(int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
+    record_tile_change(grid_offset, terrain_grid.items[grid_offset] ^ terrain);
     terrain_grid.items[grid_offset] = terrain;
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
+    record_tile_change(grid_offset, terrain & ~terrain_grid.items[grid_offset]);
     terrain_grid.items[grid_offset] |= terrain;
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
+    record_tile_change(grid_offset, terrain & terrain_grid.items[grid_offset]);
     terrain_grid.items[grid_offset] &= ~terrain;
 }
 
@@ -58,9 +93,26 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain)
 {
+    record_change(terrain);
     map_grid_and_u16(terrain_grid.items, ~terrain);
 }
 
+unsigned int map_terrain_get_change_count(int terrain)
+{
+    unsigned int count = 0;
+    for (int bit = 0; bit < NUM_TERRAIN_BITS; bit++) {
+        int type = 1 << bit;
+        if (changes.pending & type) {
+            changes.counts[bit]++;
+        }
+        if (terrain & type) {
+            count += changes.counts[bit];
+        }
+    }
+    changes.pending = 0;
+    return count;
+}
+
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
 {
     int count = 0;
@@ -325,11 +377,13 @@ void map_terrain_backup(void)
 void map_terrain_restore(void)
 {
     map_grid_copy_u16(terrain_grid_backup.items, terrain_grid.items);
+    record_change(TERRAIN_ALL);
 }
 
 void map_terrain_clear(void)
 {
     map_grid_clear_u16(terrain_grid.items);
+    record_change(TERRAIN_ALL);
 }
 
 void map_terrain_init_outside_map(void)
@@ -346,6 +400,7 @@ void map_terrain_init_outside_map(void)
             }
         }
     }
+    record_change(TERRAIN_ALL);
 }
 
 void map_terrain_save_state(buffer *buf)
@@ -356,4 +411,10 @@ void map_terrain_save_state(buffer *buf)
 void map_terrain_load_state(buffer *buf)
 {
     map_grid_load_state_u16(terrain_grid.items, buf);
+    record_change(TERRAIN_ALL);
+}
+
+uint64_t map_terrain_hash_state(void)
+{
+    return hash_xxh64(terrain_grid.items, sizeof(terrain_grid.items), 0);
 }
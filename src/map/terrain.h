@@ -46,6 +46,13 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain);
 
+/**
+ * Returns a counter that changes whenever a tile gains or loses one of the terrain types
+ * @param terrain Terrain types to check
+ * @return Change counter, only useful for comparing with an earlier value
+ */
+unsigned int map_terrain_get_change_count(int terrain);
+
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain);
 
 int map_terrain_count_diagonally_adjacent_with_type(int grid_offset, int terrain);
@@ -90,4 +97,6 @@ void map_terrain_save_state(buffer *buf);
 
 void map_terrain_load_state(buffer *buf);
 
+uint64_t map_terrain_hash_state(void);
+
 #endif // MAP_TERRAIN_H
@@ -4,7 +4,9 @@
 #include "city/view.h"
 #include "core/direction.h"
 #include "core/image.h"
+#include "core/parallel.h"
 #include "map/aqueduct.h"
+#include "map/area.h"
 #include "map/building.h"
 #include "map/building_tiles.h"
 #include "map/data.h"
@@ -27,9 +29,27 @@
 #define FORBIDDEN_TERRAIN_RUBBLE (TERRAIN_AQUEDUCT | TERRAIN_ELEVATION | TERRAIN_ACCESS_RAMP |\
             TERRAIN_ROAD | TERRAIN_BUILDING | TERRAIN_GARDEN)
 
+#define SHORE_CONTEXT_PARTS 16
+#define NOT_OPEN_WATER -2
+
 static int aqueduct_include_construction = 0;
 static int elevation_recalculate_trees = 0;
 
+static struct {
+    map_area walls;
+    map_area shores;
+    int orientation;
+} changes = {
+    { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+    { 0, 0, GRID_SIZE - 1, GRID_SIZE - 1 },
+    0
+};
+
+static struct {
+    grid_i8 context;
+    grid_u8 last_update_from;
+} shore;
+
 static int is_clear(int x, int y, int size, int disallowed_terrain, int check_image)
 {
     if (!map_grid_is_inside(x, y, size)) {
@@ -628,9 +648,39 @@ static void set_wall_image(int x, int y, int grid_offset)
     }
 }
 
+void map_tiles_mark_terrain_changed(int grid_offset, int terrain)
+{
+    if (terrain & (TERRAIN_WALL_OR_GATEHOUSE | TERRAIN_BUILDING)) {
+        map_area_add_tile(&changes.walls, grid_offset);
+    }
+    if (terrain & (TERRAIN_WATER | TERRAIN_BUILDING)) {
+        map_area_add_tile(&changes.shores, grid_offset);
+    }
+}
+
+void map_tiles_mark_building_changed(int grid_offset)
+{
+    map_area_add_tile(&changes.walls, grid_offset);
+}
+
+void map_tiles_mark_all_changed(void)
+{
+    map_area_set_all(&changes.walls);
+    map_area_set_all(&changes.shores);
+}
+
 void map_tiles_update_all_walls(void)
 {
-    foreach_map_tile(set_wall_image);
+    if (changes.orientation != city_view_orientation()) {
+        changes.orientation = city_view_orientation();
+        map_area_set_all(&changes.walls);
+    }
+    // A wall image depends on the terrain and gatehouses directly around it
+    int x_min, y_min, x_max, y_max;
+    if (map_area_get_map_region(&changes.walls, 1, &x_min, &y_min, &x_max, &y_max)) {
+        foreach_region_tile(x_min, y_min, x_max, y_max, set_wall_image);
+    }
+    map_area_clear(&changes.walls);
 }
 
 void map_tiles_update_area_walls(int x, int y, int size)
@@ -862,32 +912,53 @@ void map_tiles_update_region_meadow(int x_min, int y_min, int x_max, int y_max)
     foreach_region_tile(x_min, y_min, x_max, y_max, update_meadow_tile);
 }
 
-static void set_water_image(int x, int y, int grid_offset)
+static int has_fortified_shore(int group_offset)
 {
-    if ((map_terrain_get(grid_offset) & (TERRAIN_WATER | TERRAIN_BUILDING)) == TERRAIN_WATER) {
-        const terrain_image *img = map_image_context_get_shore(grid_offset);
-        int image_id = image_group(GROUP_TERRAIN_WATER) + img->group_offset + img->item_offset;
-        if (map_terrain_exists_tile_in_radius_with_type(x, y, 1, 2, TERRAIN_BUILDING)) {
-            // fortified shore
-            int base = image_group(GROUP_TERRAIN_WATER_SHORE);
-            switch (img->group_offset) {
-                case 8: image_id = base + 10; break;
-                case 12: image_id = base + 11; break;
-                case 16: image_id = base + 9; break;
-                case 20: image_id = base + 8; break;
-                case 24: image_id = base + 18; break;
-                case 28: image_id = base + 16; break;
-                case 32: image_id = base + 19; break;
-                case 36: image_id = base + 17; break;
-                case 50: image_id = base + 12; break;
-                case 51: image_id = base + 14; break;
-                case 52: image_id = base + 13; break;
-                case 53: image_id = base + 15; break;
-            }
+    switch (group_offset) {
+        case 8: case 12: case 16: case 20: case 24: case 28:
+        case 32: case 36: case 50: case 51: case 52: case 53:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+static int is_open_water(int grid_offset)
+{
+    return (map_terrain_get(grid_offset) & (TERRAIN_WATER | TERRAIN_BUILDING)) == TERRAIN_WATER;
+}
+
+static void set_water_image_from_context(int x, int y, int grid_offset, const terrain_image *img)
+{
+    int image_id = image_group(GROUP_TERRAIN_WATER) + img->group_offset + img->item_offset;
+    if (has_fortified_shore(img->group_offset) &&
+        map_terrain_exists_tile_in_radius_with_type(x, y, 1, 2, TERRAIN_BUILDING)) {
+        // fortified shore
+        int base = image_group(GROUP_TERRAIN_WATER_SHORE);
+        switch (img->group_offset) {
+            case 8: image_id = base + 10; break;
+            case 12: image_id = base + 11; break;
+            case 16: image_id = base + 9; break;
+            case 20: image_id = base + 8; break;
+            case 24: image_id = base + 18; break;
+            case 28: image_id = base + 16; break;
+            case 32: image_id = base + 19; break;
+            case 36: image_id = base + 17; break;
+            case 50: image_id = base + 12; break;
+            case 51: image_id = base + 14; break;
+            case 52: image_id = base + 13; break;
+            case 53: image_id = base + 15; break;
         }
-        map_image_set(grid_offset, image_id);
-        map_property_set_multi_tile_size(grid_offset, 1);
-        map_property_mark_draw_tile(grid_offset);
+    }
+    map_image_set(grid_offset, image_id);
+    map_property_set_multi_tile_size(grid_offset, 1);
+    map_property_mark_draw_tile(grid_offset);
+}
+
+static void set_water_image(int x, int y, int grid_offset)
+{
+    if (is_open_water(grid_offset)) {
+        set_water_image_from_context(x, y, grid_offset, map_image_context_get_shore(grid_offset));
     }
 }
 
@@ -898,9 +969,82 @@ static void update_water_tile(int x, int y, int grid_offset)
     }
 }
 
+static int neighbour_index(int dx, int dy)
+{
+    return (dx + 1) + 3 * (dy + 1);
+}
+
+static int is_open_water_at(int x, int y)
+{
+    return map_grid_is_inside(x, y, 1) && is_open_water(map_grid_offset(x, y));
+}
+
+static void find_shore_contexts(void *data, int part)
+{
+    const int *region = data;
+    int height = region[3] - region[1] + 1;
+    int y_min = region[1] + part * height / SHORE_CONTEXT_PARTS;
+    int y_max = region[1] + (part + 1) * height / SHORE_CONTEXT_PARTS;
+    for (int y = y_min; y < y_max; y++) {
+        int grid_offset = map_grid_offset(region[0], y);
+        for (int x = region[0]; x <= region[2]; x++, grid_offset++) {
+            if (!is_open_water(grid_offset)) {
+                shore.context.items[grid_offset] = NOT_OPEN_WATER;
+                continue;
+            }
+            shore.context.items[grid_offset] = map_image_context_find_shore(grid_offset);
+            // The tile gets its final image from the last open water tile around it in map order
+            if (is_open_water_at(x + 1, y + 1)) {
+                shore.last_update_from.items[grid_offset] = neighbour_index(1, 1);
+            } else if (is_open_water_at(x, y + 1)) {
+                shore.last_update_from.items[grid_offset] = neighbour_index(0, 1);
+            } else if (is_open_water_at(x - 1, y + 1)) {
+                shore.last_update_from.items[grid_offset] = neighbour_index(-1, 1);
+            } else if (is_open_water_at(x + 1, y)) {
+                shore.last_update_from.items[grid_offset] = neighbour_index(1, 0);
+            } else {
+                shore.last_update_from.items[grid_offset] = neighbour_index(0, 0);
+            }
+        }
+    }
+}
+
+static void update_water_tile_from_found_contexts(int x, int y, int grid_offset)
+{
+    if (shore.context.items[grid_offset] == NOT_OPEN_WATER) {
+        return;
+    }
+    int dx_min = x > 0 ? -1 : 0;
+    int dx_max = x < map_data.width - 1 ? 1 : 0;
+    int dy_min = y > 0 ? -1 : 0;
+    int dy_max = y < map_data.height - 1 ? 1 : 0;
+    for (int dy = dy_min; dy <= dy_max; dy++) {
+        for (int dx = dx_min; dx <= dx_max; dx++) {
+            int offset = grid_offset + OFFSET(dx, dy);
+            int context = shore.context.items[offset];
+            if (context == NOT_OPEN_WATER) {
+                continue;
+            }
+            // Every update moves the context on to its next image, even when the image is overwritten later
+            const terrain_image *img = map_image_context_get_shore_for_context(context);
+            if (shore.last_update_from.items[offset] == neighbour_index(-dx, -dy)) {
+                set_water_image_from_context(x + dx, y + dy, offset, img);
+            }
+        }
+    }
+}
+
 void map_tiles_update_all_water(void)
 {
-    foreach_map_tile(update_water_tile);
+    // Finding the context of each tile only reads the terrain, so it is split over threads.
+    // A context depends on the tiles around it, so only the area around changed water is looked at again.
+    // The images are then set in map order, because each context cycles through its images.
+    int region[4];
+    if (map_area_get_map_region(&changes.shores, 1, &region[0], &region[1], &region[2], &region[3])) {
+        parallel_run(find_shore_contexts, region, SHORE_CONTEXT_PARTS);
+    }
+    map_area_clear(&changes.shores);
+    foreach_map_tile(update_water_tile_from_found_contexts);
 }
 
 void map_tiles_update_region_water(int x_min, int y_min, int x_max, int y_max)
@@ -11,6 +11,21 @@ void map_tiles_determine_gardens(void);
 
 void map_tiles_update_all_plazas(void);
 
+/**
+ * Marks a tile whose terrain has changed, so that the wall images around it
+ * are updated on the next call to map_tiles_update_all_walls()
+ * @param grid_offset Offset of the changed tile
+ * @param terrain Terrain types that were added or removed
+ */
+void map_tiles_mark_terrain_changed(int grid_offset, int terrain);
+
+void map_tiles_mark_building_changed(int grid_offset);
+
+void map_tiles_mark_all_changed(void);
+
+/**
+ * Updates the wall images around tiles that changed since the previous update
+ */
 void map_tiles_update_all_walls(void);
 void map_tiles_update_area_walls(int x, int y, int size);
 int map_tiles_set_wall(int x, int y);
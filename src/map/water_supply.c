@@ -28,6 +28,13 @@ static struct {
     int tail;
 } queue;
 
+static struct {
+    int is_valid;
+    unsigned int terrain_change_count;
+    int size;
+    int items[GRID_SIZE * GRID_SIZE];
+} aqueducts;
+
 static void mark_well_access(int well_id, int radius)
 {
     building *well = building_get(well_id);
@@ -70,21 +77,38 @@ void map_water_supply_update_houses(void)
     }
 }
 
-static void set_all_aqueducts_to_no_water(void)
+static void update_aqueduct_list(void)
 {
-    int image_without_water = image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER);
+    // Only rescan the map when aqueducts were built or removed since the last time
+    unsigned int change_count = map_terrain_get_change_count(TERRAIN_AQUEDUCT);
+    if (aqueducts.is_valid && aqueducts.terrain_change_count == change_count) {
+        return;
+    }
+    aqueducts.size = 0;
     int grid_offset = map_data.start_offset;
     for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
         for (int x = 0; x < map_data.width; x++, grid_offset++) {
             if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
-                map_aqueduct_set(grid_offset, 0);
-                int image_id = map_image_at(grid_offset);
-                if (image_id < image_without_water) {
-                    map_image_set(grid_offset, image_id + 15);
-                }
+                aqueducts.items[aqueducts.size++] = grid_offset;
             }
         }
     }
+    aqueducts.terrain_change_count = change_count;
+    aqueducts.is_valid = 1;
+}
+
+static void set_all_aqueducts_to_no_water(void)
+{
+    update_aqueduct_list();
+    int image_without_water = image_group(GROUP_BUILDING_AQUEDUCT_NO_WATER);
+    for (int i = 0; i < aqueducts.size; i++) {
+        int grid_offset = aqueducts.items[i];
+        map_aqueduct_set(grid_offset, 0);
+        int image_id = map_image_at(grid_offset);
+        if (image_id < image_without_water) {
+            map_image_set(grid_offset, image_id + 15);
+        }
+    }
 }
 
 static void fill_aqueducts_from_offset(int grid_offset)
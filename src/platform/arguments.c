@@ -6,6 +6,7 @@
 #define DISPLAY_SCALE_ERROR_MESSAGE "Option --display-scale must be followed by a scale value between 0.5 and 5"
 #define WINDOWED_AND_FULLSCREEN_ERROR_MESSAGE "Option --windowed and --fullscreen cannot both be specified"
 #define DISPLAY_ID_ERROR_MESSAGE "Option --display must be followed by a number indicating the display, starting from 0"
+#define TRACE_ERROR_MESSAGE "Option --trace must be followed by the name of the file to write the trace to"
 #define UNKNOWN_OPTION_ERROR_MESSAGE "Option %s not recognized"
 
 static int parse_decimal_as_percentage(const char *str)
@@ -57,6 +58,7 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
     output_args->force_windowed = 0;
     output_args->force_fullscreen = 0;
     output_args->display_id = 0;
+    output_args->trace_file = 0;
 
     for (int i = 1; i < argc; i++) {
         // we ignore "-psn" arguments, this is needed to launch the app
@@ -101,6 +103,14 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
                 SDL_Log(DISPLAY_ID_ERROR_MESSAGE);
                 ok = 0;
             }
+        } else if (SDL_strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 < argc) {
+                output_args->trace_file = argv[i + 1];
+                i++;
+            } else {
+                SDL_Log(TRACE_ERROR_MESSAGE);
+                ok = 0;
+            }
         } else if (SDL_strcmp(argv[i], "--windowed") == 0) {
             output_args->force_windowed = 1;
         } else if (SDL_strcmp(argv[i], "--fullscreen") == 0) {
@@ -132,6 +142,8 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
         SDL_Log("          Forces the game to start fullscreen");
         SDL_Log("--display ID");
         SDL_Log("          Forces the game to start on the specified display, numbered from 0");
+        SDL_Log("--trace FILE");
+        SDL_Log("          Records performance trace events and writes them to FILE on exit");
         SDL_Log("The last argument, if present, is interpreted as data directory for the Caesar 3 installation");
     }
     return ok;
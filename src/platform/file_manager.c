@@ -1,5 +1,6 @@
 #include "file_manager.h"
 
+#include "core/dir.h"
 #include "core/file.h"
 #include "core/log.h"
 #include "core/string.h"
@@ -20,6 +21,11 @@
 #include <strings.h>
 #endif
 
+#if !defined(_WIN32) && !defined(__vita__) && !defined(__SWITCH__) && !defined(__EMSCRIPTEN__)
+#define USE_MMAP
+#include <sys/mman.h>
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 
@@ -209,6 +215,7 @@ int platform_file_manager_set_base_path(const char *path)
         log_error("set_base_path: path was not set. Julius will probably crash.", 0, 0);
         return 0;
     }
+    dir_index_reset();
 #ifdef __ANDROID__
     return android_set_base_path(path);
 #else
@@ -309,6 +316,59 @@ int platform_file_manager_remove_file(const char *filename)
 
 #endif
 
+#ifdef USE_MMAP
+
+const void *platform_file_manager_map_file(FILE *stream, size_t *size)
+{
+    struct stat file_info;
+    int fd = fileno(stream);
+    if (fstat(fd, &file_info) != 0 || file_info.st_size <= 0) {
+        return NULL;
+    }
+    void *data = mmap(NULL, file_info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    *size = file_info.st_size;
+    return data;
+}
+
+void platform_file_manager_unmap_file(const void *data, size_t size)
+{
+    munmap((void *) data, size);
+}
+
+#else
+
+const void *platform_file_manager_map_file(FILE *stream, size_t *size)
+{
+    return NULL;
+}
+
+void platform_file_manager_unmap_file(const void *data, size_t size)
+{
+}
+
+#endif
+
+int platform_file_manager_get_file_stamp(FILE *stream, int64_t *size, int64_t *modified)
+{
+#ifdef _MSC_VER
+    struct _stat64 file_info;
+    if (_fstat64(_fileno(stream), &file_info) != 0) {
+        return 0;
+    }
+#else
+    struct stat file_info;
+    if (fstat(fileno(stream), &file_info) != 0) {
+        return 0;
+    }
+#endif
+    *size = file_info.st_size;
+    *modified = file_info.st_mtime;
+    return 1;
+}
+
 int platform_file_manager_close_file(FILE *stream)
 {
     int result = fclose(stream);
@@ -1,6 +1,7 @@
 #ifndef PLATFORM_FILE_MANAGER_H
 #define PLATFORM_FILE_MANAGER_H
 
+#include <stdint.h>
 #include <stdio.h>
 
 enum {
@@ -74,6 +75,30 @@ FILE *platform_file_manager_open_file(const char *filename, const char *mode);
  */
 int platform_file_manager_close_file(FILE *stream);
 
+/**
+ * Maps an opened file into memory for reading
+ * @param stream The stream to map
+ * @param size Output: size of the mapping in bytes
+ * @return Pointer to the read-only file contents, or NULL if the platform does not support mapping
+ */
+const void *platform_file_manager_map_file(FILE *stream, size_t *size);
+
+/**
+ * Releases a mapping created with platform_file_manager_map_file
+ * @param data The mapped contents
+ * @param size Size of the mapping in bytes
+ */
+void platform_file_manager_unmap_file(const void *data, size_t size);
+
+/**
+ * Gets the size and last modification time of an opened file
+ * @param stream The stream to check
+ * @param size Output: size of the file in bytes
+ * @param modified Output: last modification time, in seconds since the epoch
+ * @return true if the information could be retrieved, false otherwise
+ */
+int platform_file_manager_get_file_stamp(FILE *stream, int64_t *size, int64_t *modified);
+
 /**
  * Removes a file
  * @param filename The file to remove
@@ -7,9 +7,12 @@
 #include "core/lang.h"
 #include "core/time.h"
 #include "game/game.h"
+#include "game/perf.h"
 #include "game/settings.h"
 #include "game/system.h"
+#include "game/trace.h"
 #include "graphics/screen.h"
+#include "graphics/window.h"
 #include "input/mouse.h"
 #include "input/touch.h"
 #include "platform/arguments.h"
@@ -21,6 +24,7 @@
 #include "platform/prefs.h"
 #include "platform/screen.h"
 #include "platform/touch.h"
+#include "widget/perf_hud.h"
 
 #include "tinyfiledialogs/tinyfiledialogs.h"
 
@@ -41,12 +45,6 @@
 #define SHOW_FOLDER_SELECT_DIALOG
 #endif
 
-#ifdef DRAW_FPS
-#include "graphics/window.h"
-#include "graphics/graphics.h"
-#include "graphics/text.h"
-#endif
-
 #define INTPTR(d) (*(int*)(d))
 
 enum {
@@ -60,7 +58,8 @@ enum {
 static struct {
     int active;
     int quit;
-} data = { 1, 0 };
+    const char *trace_file;
+} data = { 1, 0, 0 };
 
 static void exit_with_status(int status)
 {
@@ -123,6 +122,16 @@ static void post_event(int code)
     SDL_PushEvent(&event);
 }
 
+uint64_t system_get_time_us(void)
+{
+    static Uint64 frequency;
+    if (!frequency) {
+        frequency = SDL_GetPerformanceFrequency();
+    }
+    Uint64 counter = SDL_GetPerformanceCounter();
+    return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+}
+
 void system_exit(void)
 {
     post_event(USER_EVENT_QUIT);
@@ -161,55 +170,29 @@ static void platform_per_frame_callback(void)
 }
 #endif
 
-#ifdef DRAW_FPS
-static struct {
-    int frame_count;
-    int last_fps;
-    Uint32 last_update_time;
-} fps;
-
-static void run_and_draw(void)
+static void draw_performance_hud(void)
 {
-    time_millis time_before_run = SDL_GetTicks();
-    time_set_millis(time_before_run);
-
-    game_run();
-    Uint32 time_between_run_and_draw = SDL_GetTicks();
-    game_draw();
-    Uint32 time_after_draw = SDL_GetTicks();
-
-    fps.frame_count++;
-    if (time_after_draw - fps.last_update_time > 1000) {
-        fps.last_fps = fps.frame_count;
-        fps.last_update_time = time_after_draw;
-        fps.frame_count = 0;
-    }
-    if (window_is(WINDOW_CITY) || window_is(WINDOW_CITY_MILITARY) || window_is(WINDOW_SLIDING_SIDEBAR)) {
-        int y_offset = 24;
-        int y_offset_text = y_offset + 5;
-        graphics_fill_rect(0, y_offset, 100, 20, COLOR_WHITE);
-        text_draw_number_colored(fps.last_fps,
-            'f', "", 5, y_offset_text, FONT_NORMAL_PLAIN, COLOR_FONT_RED);
-        text_draw_number_colored(time_between_run_and_draw - time_before_run,
-            'g', "", 40, y_offset_text, FONT_NORMAL_PLAIN, COLOR_FONT_RED);
-        text_draw_number_colored(time_after_draw - time_between_run_and_draw,
-            'd', "", 70, y_offset_text, FONT_NORMAL_PLAIN, COLOR_FONT_RED);
+    if (perf_is_enabled() &&
+        (window_is(WINDOW_CITY) || window_is(WINDOW_CITY_MILITARY) || window_is(WINDOW_SLIDING_SIDEBAR))) {
+        widget_perf_hud_draw(0, 24);
     }
-    platform_screen_update();
-    platform_screen_render();
 }
-#else
+
 static void run_and_draw(void)
 {
     time_set_millis(SDL_GetTicks());
 
-    game_run();
     game_draw();
+    draw_performance_hud();
 
+    // The simulation only touches the game state, so it can run while the frame is presented
+    game_run_start();
+    uint64_t start = perf_start();
     platform_screen_update();
+    perf_stop(PERF_TEXTURE_UPLOAD, start);
     platform_screen_render();
+    perf_end_frame();
 }
-#endif
 
 static void handle_mouse_button(SDL_MouseButtonEvent *event, int is_down)
 {
@@ -353,6 +336,10 @@ static void teardown(void)
 {
     SDL_Log("Exiting game");
     game_exit();
+    if (data.trace_file) {
+        trace_save(data.trace_file);
+        trace_stop();
+    }
     platform_screen_destroy();
     SDL_Quit();
     teardown_logging();
@@ -361,6 +348,8 @@ static void teardown(void)
 static void main_loop(void)
 {
     SDL_Event event;
+    // Input handlers read the game state, so the simulation has to be done first
+    game_run_wait();
 #ifdef PLATFORM_ENABLE_PER_FRAME_CALLBACK
     platform_per_frame_callback();
 #endif
@@ -530,6 +519,10 @@ static void setup(const julius_args *args)
 
     SDL_Log("Julius version %s", system_version());
 
+    if (args->trace_file && trace_start()) {
+        data.trace_file = args->trace_file;
+    }
+
     if (!init_sdl()) {
         SDL_Log("Exiting: SDL init failed");
         exit_with_status(-1);
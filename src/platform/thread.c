@@ -0,0 +1,77 @@
+#include "core/thread.h"
+
+#include "SDL.h"
+
+thread *thread_create(int (*function)(void *), void *data, const char *name)
+{
+    return (thread *) SDL_CreateThread(function, name, data);
+}
+
+int thread_get_cpu_count(void)
+{
+    return SDL_GetCPUCount();
+}
+
+unsigned long thread_current_id(void)
+{
+    return SDL_ThreadID();
+}
+
+int thread_wait(thread *t)
+{
+    int status = 0;
+    SDL_WaitThread((SDL_Thread *) t, &status);
+    return status;
+}
+
+thread_mutex *thread_mutex_create(void)
+{
+    return (thread_mutex *) SDL_CreateMutex();
+}
+
+void thread_mutex_lock(thread_mutex *mutex)
+{
+    if (mutex) {
+        SDL_LockMutex((SDL_mutex *) mutex);
+    }
+}
+
+void thread_mutex_unlock(thread_mutex *mutex)
+{
+    if (mutex) {
+        SDL_UnlockMutex((SDL_mutex *) mutex);
+    }
+}
+
+void thread_mutex_destroy(thread_mutex *mutex)
+{
+    if (mutex) {
+        SDL_DestroyMutex((SDL_mutex *) mutex);
+    }
+}
+
+thread_semaphore *thread_semaphore_create(int value)
+{
+    return (thread_semaphore *) SDL_CreateSemaphore(value);
+}
+
+void thread_semaphore_post(thread_semaphore *semaphore)
+{
+    if (semaphore) {
+        SDL_SemPost((SDL_sem *) semaphore);
+    }
+}
+
+void thread_semaphore_wait(thread_semaphore *semaphore)
+{
+    if (semaphore) {
+        SDL_SemWait((SDL_sem *) semaphore);
+    }
+}
+
+void thread_semaphore_destroy(thread_semaphore *semaphore)
+{
+    if (semaphore) {
+        SDL_DestroySemaphore((SDL_sem *) semaphore);
+    }
+}
@@ -4,6 +4,7 @@
 #include "city/figures.h"
 #include "city/population.h"
 #include "game/settings.h"
+#include "game/trace.h"
 #include "sound/device.h"
 
 enum {
@@ -59,12 +60,14 @@ static void play_track(int track)
     if (track <= TRACK_NONE || track >= TRACK_MAX) {
         return;
     }
+    uint64_t trace_start_time = trace_begin();
     const char *mp3_track = dir_get_file(mp3_tracks[track], NOT_LOCALIZED);
 
     int volume = setting_sound(SOUND_MUSIC)->volume;
     if (!mp3_track || !sound_device_play_music(mp3_track, volume)) {
         sound_device_play_music(dir_get_file(tracks[track], NOT_LOCALIZED), volume);
     }
+    trace_end("play_track", trace_start_time);
     data.current_track = track;
 }
 
@@ -2,6 +2,7 @@
 
 #include "core/dir.h"
 #include "game/settings.h"
+#include "game/trace.h"
 #include "sound/channel.h"
 #include "sound/city.h"
 #include "sound/device.h"
@@ -185,8 +186,8 @@ void sound_system_init(void)
 {
     correct_channel_filenames();
 
-    sound_device_open();
-    sound_device_init_channels(SOUND_CHANNEL_MAX, channel_filenames);
+    TRACE_CALL(sound_device_open());
+    TRACE_CALL(sound_device_init_channels(SOUND_CHANNEL_MAX, channel_filenames));
 
     sound_city_set_volume(setting_sound(SOUND_CITY)->volume);
     sound_effect_set_volume(setting_sound(SOUND_EFFECTS)->volume);
@@ -105,10 +105,29 @@ static translation_string all_strings[] = {
     {TR_HOTKEY_SET_BOOKMARK_3, "Set bookmark 3"},
     {TR_HOTKEY_SET_BOOKMARK_4, "Set bookmark 4"},
     {TR_HOTKEY_EDITOR_TOGGLE_BATTLE_INFO, "Toggle battle info"},
+    {TR_HOTKEY_HEADER_QUICKSAVE, "Quicksave slots"},
+    {TR_HOTKEY_QUICKLOAD_1, "Quickload slot 1"},
+    {TR_HOTKEY_QUICKLOAD_2, "Quickload slot 2"},
+    {TR_HOTKEY_QUICKLOAD_3, "Quickload slot 3"},
+    {TR_HOTKEY_QUICKLOAD_4, "Quickload slot 4"},
+    {TR_HOTKEY_QUICKSAVE_1, "Quicksave slot 1"},
+    {TR_HOTKEY_QUICKSAVE_2, "Quicksave slot 2"},
+    {TR_HOTKEY_QUICKSAVE_3, "Quicksave slot 3"},
+    {TR_HOTKEY_QUICKSAVE_4, "Quicksave slot 4"},
     {TR_HOTKEY_EDIT_TITLE, "Press new hotkey"},
     {TR_HOTKEY_DUPLICATE_TITLE, "Hotkey already used"},
     {TR_HOTKEY_DUPLICATE_MESSAGE, "This key combination is already assigned to the following action:"},
     {TR_WARNING_SCREENSHOT_SAVED, "Screenshot saved: "},
+    {TR_SAVE_DIALOG_SORT_BY_NAME, "Sorted by name"},
+    {TR_SAVE_DIALOG_SORT_BY_LAST_SAVED, "Sorted by last saved"},
+    {TR_SAVE_DIALOG_SORT_BY_POPULATION, "Sorted by population"},
+    {TR_SAVE_DIALOG_POPULATION, "Population: "},
+    {TR_GAME_SPEED_UNLIMITED, "Max"},
+    {TR_GAME_SPEED_TICKS_PER_SECOND, " ticks/s"},
+    {TR_HOTKEY_TOGGLE_PERFORMANCE_HUD, "Show performance info"},
+    {TR_HOTKEY_SAVE_PERFORMANCE_TRACE, "Record/save performance trace"},
+    {TR_WARNING_TRACE_RECORDING, "Recording performance trace"},
+    {TR_WARNING_TRACE_SAVED, "Performance trace saved: "},
 };
 
 void translation_english(const translation_string **strings, int *num_strings)
@@ -97,10 +97,29 @@ typedef enum {
     TR_HOTKEY_SET_BOOKMARK_3,
     TR_HOTKEY_SET_BOOKMARK_4,
     TR_HOTKEY_EDITOR_TOGGLE_BATTLE_INFO,
+    TR_HOTKEY_HEADER_QUICKSAVE,
+    TR_HOTKEY_QUICKLOAD_1,
+    TR_HOTKEY_QUICKLOAD_2,
+    TR_HOTKEY_QUICKLOAD_3,
+    TR_HOTKEY_QUICKLOAD_4,
+    TR_HOTKEY_QUICKSAVE_1,
+    TR_HOTKEY_QUICKSAVE_2,
+    TR_HOTKEY_QUICKSAVE_3,
+    TR_HOTKEY_QUICKSAVE_4,
     TR_HOTKEY_EDIT_TITLE,
     TR_HOTKEY_DUPLICATE_TITLE,
     TR_HOTKEY_DUPLICATE_MESSAGE,
     TR_WARNING_SCREENSHOT_SAVED,
+    TR_SAVE_DIALOG_SORT_BY_NAME,
+    TR_SAVE_DIALOG_SORT_BY_LAST_SAVED,
+    TR_SAVE_DIALOG_SORT_BY_POPULATION,
+    TR_SAVE_DIALOG_POPULATION,
+    TR_GAME_SPEED_UNLIMITED,
+    TR_GAME_SPEED_TICKS_PER_SECOND,
+    TR_HOTKEY_TOGGLE_PERFORMANCE_HUD,
+    TR_HOTKEY_SAVE_PERFORMANCE_TRACE,
+    TR_WARNING_TRACE_RECORDING,
+    TR_WARNING_TRACE_SAVED,
     TRANSLATION_MAX_KEY
 } translation_key;
 
@@ -6,6 +6,7 @@
 #include "city/view.h"
 #include "core/config.h"
 #include "core/log.h"
+#include "game/perf.h"
 #include "game/resource.h"
 #include "game/state.h"
 #include "graphics/image.h"
@@ -544,6 +545,7 @@ void city_with_overlay_draw(const map_tile *tile)
         return;
     }
 
+    uint64_t start = perf_start();
     int should_mark_deleting = city_building_ghost_mark_deleting(tile);
     city_view_foreach_map_tile(draw_footprint);
     if (!should_mark_deleting) {
@@ -560,6 +562,7 @@ void city_with_overlay_draw(const map_tile *tile)
         city_view_foreach_valid_map_tile(deletion_draw_animations);
         city_view_foreach_valid_map_tile(draw_elevated_figures);
     }
+    perf_stop(PERF_DRAW_OVERLAY, start);
 }
 
 int city_with_overlay_get_tooltip_text(tooltip_context *c, int grid_offset)
@@ -12,6 +12,7 @@
 #include "core/config.h"
 #include "core/time.h"
 #include "figure/formation_legion.h"
+#include "game/perf.h"
 #include "game/resource.h"
 #include "graphics/image.h"
 #include "graphics/window.h"
@@ -519,13 +520,19 @@ void city_without_overlay_draw(int selected_figure_id, pixel_coordinate *figure_
     }
     init_draw_context(selected_figure_id, figure_coord, highlighted_formation);
     int should_mark_deleting = city_building_ghost_mark_deleting(tile);
+    uint64_t start = perf_start();
     city_view_foreach_map_tile(draw_footprint);
+    perf_stop(PERF_DRAW_FOOTPRINTS, start);
+    // Figures on the ground are drawn row by row between the building tops, so they count as tops
+    start = perf_start();
     if (!should_mark_deleting) {
         city_view_foreach_valid_map_tile_row(
             draw_top,
             draw_figures,
             draw_animation
         );
+        perf_stop(PERF_DRAW_TOPS, start);
+        start = perf_start();
         if (!selected_figure_id) {
             city_building_ghost_draw(tile);
         }
@@ -536,7 +543,10 @@ void city_without_overlay_draw(int selected_figure_id, pixel_coordinate *figure_
         );
     } else {
         city_view_foreach_valid_map_tile(deletion_draw_terrain_top);
+        perf_stop(PERF_DRAW_TOPS, start);
+        start = perf_start();
         city_view_foreach_valid_map_tile(deletion_draw_figures_animations);
         city_view_foreach_valid_map_tile(deletion_draw_remaining);
     }
+    perf_stop(PERF_DRAW_FIGURES, start);
 }
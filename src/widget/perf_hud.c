@@ -0,0 +1,179 @@
+#include "perf_hud.h"
+
+#include "building/building.h"
+#include "core/string.h"
+#include "figure/figure.h"
+#include "figure/route.h"
+#include "game/perf.h"
+#include "graphics/graphics.h"
+#include "graphics/text.h"
+
+#include <stdio.h>
+
+#define WIDTH 260
+#define HEIGHT 165
+#define GRAPH_WIDTH PERF_HISTORY_SIZE
+#define GRAPH_HEIGHT 40
+#define LINE_HEIGHT 13
+
+#define COLOR_BACKGROUND 0x202020
+#define COLOR_GRAPH_BACKGROUND 0x404040
+#define COLOR_TARGET_LINE 0x808080
+
+#define FRAME_TARGET_US 16667
+
+static const struct {
+    perf_counter counter;
+    const char *name;
+    color_t color;
+} DRAW_PASSES[] = {
+    {PERF_DRAW_FOOTPRINTS, "footprints", 0x18c018},
+    {PERF_DRAW_TOPS, "tops", 0xe7e75a},
+    {PERF_DRAW_FIGURES, "figures", 0xff5a08},
+    {PERF_DRAW_OVERLAY, "overlay", 0x0055ff},
+    {PERF_DRAW_UI, "ui", 0xb3b3b3},
+    {PERF_TEXTURE_UPLOAD, "upload", 0xff0000},
+};
+
+#define NUM_DRAW_PASSES ((int) (sizeof(DRAW_PASSES) / sizeof(DRAW_PASSES[0])))
+
+static void draw_text(const char *text, int x, int y, color_t color)
+{
+    text_draw(string_from_ascii(text), x, y, FONT_NORMAL_PLAIN, color);
+}
+
+static void format_ms(char *buffer, int size, const char *prefix, int time_us)
+{
+    snprintf(buffer, size, "%s%d.%d ms", prefix, time_us / 1000, time_us % 1000 / 100);
+}
+
+static int bar_height(int time_us, int scale_us)
+{
+    int height = time_us * GRAPH_HEIGHT / scale_us;
+    return height > GRAPH_HEIGHT ? GRAPH_HEIGHT : height;
+}
+
+static int get_max(perf_counter counter)
+{
+    int max = 0;
+    for (int age = 0; age < PERF_HISTORY_SIZE; age++) {
+        int value = perf_get(counter, age);
+        if (value > max) {
+            max = value;
+        }
+    }
+    return max;
+}
+
+static void draw_graph(int x, int y, perf_counter counter, int scale_us, int target_us, color_t color)
+{
+    graphics_fill_rect(x, y, GRAPH_WIDTH, GRAPH_HEIGHT, COLOR_GRAPH_BACKGROUND);
+    int bottom = y + GRAPH_HEIGHT - 1;
+    for (int age = 0; age < PERF_HISTORY_SIZE; age++) {
+        int height = bar_height(perf_get(counter, age), scale_us);
+        if (height > 0) {
+            int xx = x + GRAPH_WIDTH - 1 - age;
+            graphics_draw_vertical_line(xx, bottom - height + 1, bottom, color);
+        }
+    }
+    if (target_us && target_us < scale_us) {
+        graphics_draw_horizontal_line(x, x + GRAPH_WIDTH - 1, bottom - bar_height(target_us, scale_us),
+            COLOR_TARGET_LINE);
+    }
+}
+
+static void draw_passes_graph(int x, int y, int scale_us)
+{
+    graphics_fill_rect(x, y, GRAPH_WIDTH, GRAPH_HEIGHT, COLOR_GRAPH_BACKGROUND);
+    int bottom = y + GRAPH_HEIGHT - 1;
+    for (int age = 0; age < PERF_HISTORY_SIZE; age++) {
+        int xx = x + GRAPH_WIDTH - 1 - age;
+        int total_us = 0;
+        int y_from = bottom;
+        for (int i = 0; i < NUM_DRAW_PASSES; i++) {
+            total_us += perf_get(DRAW_PASSES[i].counter, age);
+            int y_to = bottom - bar_height(total_us, scale_us);
+            if (y_to < y_from) {
+                graphics_draw_vertical_line(xx, y_to + 1, y_from, DRAW_PASSES[i].color);
+                y_from = y_to;
+            }
+        }
+    }
+    graphics_draw_horizontal_line(x, x + GRAPH_WIDTH - 1, bottom - bar_height(FRAME_TARGET_US, scale_us),
+        COLOR_TARGET_LINE);
+}
+
+static int scale_for(int max_us, int min_scale_us)
+{
+    return max_us > min_scale_us ? max_us : min_scale_us;
+}
+
+static void draw_counts(int x, int y)
+{
+    int figures = 0;
+    for (int i = 1; i < MAX_FIGURES; i++) {
+        if (figure_get(i)->state == FIGURE_STATE_ALIVE) {
+            figures++;
+        }
+    }
+    int buildings = 0;
+    for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (building_get(i)->state != BUILDING_STATE_UNUSED) {
+            buildings++;
+        }
+    }
+    char text[100];
+    snprintf(text, sizeof(text), "figures %d  buildings %d  routes %d/%d",
+        figures, buildings, figure_route_get_used_paths(), figure_route_get_max_paths());
+    draw_text(text, x, y, COLOR_WHITE);
+}
+
+void widget_perf_hud_draw(int x, int y)
+{
+    char text[100];
+    graphics_fill_rect(x, y, WIDTH, HEIGHT, COLOR_BACKGROUND);
+    x += 5;
+    y += 5;
+
+    int frame_us = perf_get_average(PERF_FRAME);
+    snprintf(text, sizeof(text), "%d fps", frame_us ? 1000000 / frame_us : 0);
+    draw_text(text, x, y, COLOR_WHITE);
+    format_ms(text, sizeof(text), "frame ", frame_us);
+    draw_text(text, x + 50, y, COLOR_WHITE);
+    format_ms(text, sizeof(text), "tick ", perf_get_average(PERF_TICK));
+    draw_text(text, x + GRAPH_WIDTH + 5, y, COLOR_WHITE);
+    y += LINE_HEIGHT + 2;
+
+    int max_frame_us = get_max(PERF_FRAME);
+    int max_tick_us = get_max(PERF_TICK);
+    draw_graph(x, y, PERF_FRAME, scale_for(max_frame_us, 2 * FRAME_TARGET_US), FRAME_TARGET_US, COLOR_WHITE);
+    draw_graph(x + GRAPH_WIDTH + 5, y, PERF_TICK, scale_for(max_tick_us, 1000), 0, COLOR_WHITE);
+    y += GRAPH_HEIGHT + 2;
+    format_ms(text, sizeof(text), "max ", max_frame_us);
+    draw_text(text, x, y, COLOR_WHITE);
+    format_ms(text, sizeof(text), "max ", max_tick_us);
+    draw_text(text, x + GRAPH_WIDTH + 5, y, COLOR_WHITE);
+    y += LINE_HEIGHT + 4;
+
+    int max_draw_us = 0;
+    for (int age = 0; age < PERF_HISTORY_SIZE; age++) {
+        int total_us = 0;
+        for (int i = 0; i < NUM_DRAW_PASSES; i++) {
+            total_us += perf_get(DRAW_PASSES[i].counter, age);
+        }
+        if (total_us > max_draw_us) {
+            max_draw_us = total_us;
+        }
+    }
+    draw_passes_graph(x, y, scale_for(max_draw_us, FRAME_TARGET_US));
+    int legend_y = y - 3;
+    for (int i = 0; i < NUM_DRAW_PASSES; i++) {
+        format_ms(text, sizeof(text), "", perf_get_average(DRAW_PASSES[i].counter));
+        draw_text(DRAW_PASSES[i].name, x + GRAPH_WIDTH + 5, legend_y, DRAW_PASSES[i].color);
+        draw_text(text, x + GRAPH_WIDTH + 75, legend_y, DRAW_PASSES[i].color);
+        legend_y += LINE_HEIGHT - 2;
+    }
+    y = legend_y + 4;
+
+    draw_counts(x, y);
+}
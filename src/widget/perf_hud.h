@@ -0,0 +1,6 @@
+#ifndef WIDGET_PERF_HUD_H
+#define WIDGET_PERF_HUD_H
+
+void widget_perf_hud_draw(int x, int y);
+
+#endif // WIDGET_PERF_HUD_H
@@ -7,6 +7,7 @@
 #include "core/lang.h"
 #include "core/string.h"
 #include "game/settings.h"
+#include "game/speed.h"
 #include "graphics/arrow_button.h"
 #include "graphics/graphics.h"
 #include "graphics/lang_text.h"
@@ -15,6 +16,7 @@
 #include "graphics/text.h"
 #include "scenario/criteria.h"
 #include "scenario/property.h"
+#include "translation/translation.h"
 
 #define EXTRA_INFO_LINE_SPACE 16
 #define EXTRA_INFO_HEIGHT_GAME_SPEED 64
@@ -42,6 +44,7 @@ static struct {
     int is_collapsed;
     sidebar_extra_display info_to_display;
     int game_speed;
+    int ticks_per_second;
     int unemployment_percentage;
     int unemployment_amount;
     objective culture;
@@ -143,6 +146,9 @@ static int update_extra_info(int is_background)
     int changed = 0;
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_GAME_SPEED) {
         changed |= update_extra_info_value(setting_game_speed(), &data.game_speed);
+        if (data.game_speed == GAME_SPEED_UNLIMITED) {
+            changed |= update_extra_info_value(game_speed_get_ticks_per_second(), &data.ticks_per_second);
+        }
     }
     if (data.info_to_display & SIDEBAR_EXTRA_DISPLAY_UNEMPLOYMENT) {
         changed |= update_extra_info_value(city_labor_unemployment_percentage(), &data.unemployment_percentage);
@@ -204,7 +210,14 @@ static void draw_extra_info_panel(void)
         lang_text_draw(45, 2, data.x_offset + 10, y_current_line, FONT_NORMAL_WHITE);
         y_current_line += EXTRA_INFO_LINE_SPACE + EXTRA_INFO_VERTICAL_PADDING;
 
-        text_draw_percentage(data.game_speed, data.x_offset + 60, y_current_line - 2, FONT_NORMAL_GREEN);
+        if (data.game_speed == GAME_SPEED_UNLIMITED) {
+            int width = text_draw_number(data.ticks_per_second, '@', "",
+                data.x_offset + 10, y_current_line - 2, FONT_NORMAL_GREEN);
+            text_draw(translation_for(TR_GAME_SPEED_TICKS_PER_SECOND),
+                data.x_offset + 10 + width, y_current_line - 2, FONT_NORMAL_GREEN, 0);
+        } else {
+            text_draw_percentage(data.game_speed, data.x_offset + 60, y_current_line - 2, FONT_NORMAL_GREEN);
+        }
 
         y_current_line += EXTRA_INFO_VERTICAL_PADDING * 3;
     }
@@ -10,6 +10,7 @@
 #include "core/config.h"
 #include "figure/formation.h"
 #include "figure/formation_legion.h"
+#include "game/file.h"
 #include "game/orientation.h"
 #include "game/settings.h"
 #include "game/state.h"
@@ -247,6 +248,14 @@ static void handle_hotkeys(const hotkeys *h)
     if (h->save_file) {
         window_file_dialog_show(FILE_TYPE_SAVED_GAME, FILE_DIALOG_SAVE);
     }
+    if (h->quicksave) {
+        game_file_quicksave(h->quicksave - 1);
+    }
+    if (h->quickload) {
+        if (game_file_quickload(h->quickload - 1)) {
+            window_city_show();
+        }
+    }
     if (h->building) {
         set_construction_building_type(h->building);
     }
@@ -10,6 +10,8 @@
 #include "core/time.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/save_index.h"
+#include "graphics/button.h"
 #include "graphics/generic_button.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -21,19 +23,31 @@
 #include "graphics/window.h"
 #include "input/input.h"
 #include "platform/file_manager.h"
+#include "translation/translation.h"
 #include "widget/input_box.h"
 #include "window/city.h"
 #include "window/editor/map.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 #define NUM_FILES_IN_VIEW 12
 #define MAX_FILE_WINDOW_TEXT_WIDTH (18 * BLOCK_SIZE)
+// Extra room below the file list for the saved game summary and the sort button
+#define SUMMARY_HEIGHT (4 * BLOCK_SIZE)
+
+enum {
+    SORT_BY_NAME = 0,
+    SORT_BY_LAST_SAVED = 1,
+    SORT_BY_POPULATION = 2,
+    MAX_SORT = 3
+};
 
 static const time_millis NOT_EXIST_MESSAGE_TIMEOUT = 500;
 
 static void button_ok_cancel(int is_ok, int param2);
 static void button_select_file(int index, int param2);
+static void button_sort(int param1, int param2);
 static void on_scroll(void);
 
 static image_button image_buttons[] = {
@@ -55,6 +69,8 @@ static generic_button file_buttons[] = {
     {160, 304, 288, 16, button_select_file, button_none, 11, 0},
 };
 
+static generic_button sort_button = {144, 370, 320, 20, button_sort, button_none, 0, 0};
+
 static scrollbar_type scrollbar = {464, 120, 206, 320, NUM_FILES_IN_VIEW, on_scroll, 1};
 
 typedef struct {
@@ -67,7 +83,10 @@ static struct {
     file_type type;
     file_dialog_type dialog_type;
     int focus_button_id;
+    int focus_sort_button;
     int double_click;
+    int sort_mode;
+    int index_complete;
     const dir_listing *file_list;
 
     file_type_data *file_data;
@@ -81,6 +100,48 @@ static input_box file_name_input = {144, 80, 20, 2, FONT_NORMAL_WHITE, 0, data.t
 static file_type_data saved_game_data = {"sav"};
 static file_type_data scenario_data = {"map"};
 
+static int has_summary(void)
+{
+    return data.type == FILE_TYPE_SAVED_GAME;
+}
+
+static int compare_name(const void *va, const void *vb)
+{
+    return platform_file_manager_compare_filename(*(const char **) va, *(const char **) vb);
+}
+
+static int compare_last_saved(const void *va, const void *vb)
+{
+    int64_t a = save_index_get_modified_time(*(const char **) va);
+    int64_t b = save_index_get_modified_time(*(const char **) vb);
+    if (a != b) {
+        return a > b ? -1 : 1;
+    }
+    return compare_name(va, vb);
+}
+
+static int compare_population(const void *va, const void *vb)
+{
+    const saved_game_info *a = save_index_get(*(const char **) va);
+    const saved_game_info *b = save_index_get(*(const char **) vb);
+    int population_a = a ? a->population : -1;
+    int population_b = b ? b->population : -1;
+    if (population_a != population_b) {
+        return population_a > population_b ? -1 : 1;
+    }
+    return compare_name(va, vb);
+}
+
+static void sort_files(void)
+{
+    // The directory listing is always sorted by name
+    if (!has_summary() || data.sort_mode == SORT_BY_NAME) {
+        return;
+    }
+    qsort(data.file_list->files, data.file_list->num_files, sizeof(char *),
+        data.sort_mode == SORT_BY_LAST_SAVED ? compare_last_saved : compare_population);
+}
+
 static int find_first_file_with_prefix(const char *prefix)
 {
     int len = (int) strlen(prefix);
@@ -111,6 +172,10 @@ static void scroll_to_typed_text(void)
         // No need to scroll
         return;
     }
+    if (has_summary() && data.sort_mode != SORT_BY_NAME) {
+        // Searching by prefix only works on a list sorted by name
+        return;
+    }
     char name_utf8[FILE_NAME_MAX];
     encoding_to_utf8(data.typed_name, name_utf8, FILE_NAME_MAX, encoding_system_uses_decomposed());
     int index = find_first_file_with_prefix(name_utf8);
@@ -128,6 +193,8 @@ static void init(file_type type, file_dialog_type dialog_type)
     data.message_not_exist_start_time = 0;
     data.double_click = 0;
     data.focus_button_id = 0;
+    data.focus_sort_button = 0;
+    data.index_complete = 0;
 
     if (strlen(data.file_data->last_loaded_file) > 0) {
         encoding_from_utf8(data.file_data->last_loaded_file, data.typed_name, FILE_NAME_MAX);
@@ -142,6 +209,10 @@ static void init(file_type type, file_dialog_type dialog_type)
     string_copy(data.typed_name, data.previously_seen_typed_name, FILE_NAME_MAX);
 
     data.file_list = dir_find_files_with_extension(data.file_data->extension);
+    if (has_summary()) {
+        save_index_start(data.file_list);
+        sort_files();
+    }
     scrollbar_init(&scrollbar, 0, data.file_list->num_files);
     scroll_to_typed_text();
 
@@ -149,12 +220,35 @@ static void init(file_type type, file_dialog_type dialog_type)
     input_box_start(&file_name_input);
 }
 
+static void draw_summary(void)
+{
+    const char *filename = data.selected_file;
+    if (data.focus_button_id && scrollbar.scroll_position + data.focus_button_id <= data.file_list->num_files) {
+        filename = data.file_list->files[scrollbar.scroll_position + data.focus_button_id - 1];
+    }
+    const saved_game_info *info = save_index_get(filename);
+    if (info) {
+        uint8_t scenario_name[MAX_SCENARIO_NAME];
+        string_copy(info->scenario_name, scenario_name, MAX_SCENARIO_NAME);
+        text_ellipsize(scenario_name, FONT_NORMAL_BLACK, 170);
+        text_draw(scenario_name, 160, 336, FONT_NORMAL_BLACK, 0);
+        lang_text_draw_month_year_max_width(info->month, info->year, 340, 336, 124, FONT_NORMAL_BLACK, 0);
+        int width = text_draw(translation_for(TR_SAVE_DIALOG_POPULATION), 160, 352, FONT_NORMAL_BLACK, 0);
+        text_draw_number(info->population, '@', " ", 160 + width, 352, FONT_NORMAL_BLACK);
+        text_draw_money(info->treasury, 340, 352, FONT_NORMAL_BLACK);
+    }
+    button_border_draw(sort_button.x, sort_button.y, sort_button.width, sort_button.height, data.focus_sort_button);
+    text_draw_centered(translation_for(TR_SAVE_DIALOG_SORT_BY_NAME + data.sort_mode),
+        sort_button.x, sort_button.y + 5, sort_button.width, FONT_NORMAL_BLACK, 0);
+}
+
 static void draw_foreground(void)
 {
     graphics_in_dialog();
     uint8_t file[FILE_NAME_MAX];
+    int summary_height = has_summary() ? SUMMARY_HEIGHT : 0;
 
-    outer_panel_draw(128, 40, 24, 21);
+    outer_panel_draw(128, 40, 24, 21 + summary_height / BLOCK_SIZE);
     input_box_draw(&file_name_input);
     inner_panel_draw(144, 120, 20, 13);
 
@@ -168,7 +262,7 @@ static void draw_foreground(void)
         int text_id = data.dialog_type + (data.type == FILE_TYPE_SCENARIO ? 3 : 0);
         lang_text_draw_centered(43, text_id, 160, 50, 304, FONT_LARGE_BLACK);
     }
-    lang_text_draw(43, 5, 224, 342, FONT_NORMAL_BLACK);
+    lang_text_draw(43, 5, 224, 342 + summary_height, FONT_NORMAL_BLACK);
 
     for (int i = 0; i < NUM_FILES_IN_VIEW; i++) {
         font_t font = FONT_NORMAL_GREEN;
@@ -181,7 +275,10 @@ static void draw_foreground(void)
         text_draw(file, 160, 130 + 16 * i, font, 0);
     }
 
-    image_buttons_draw(0, 0, image_buttons, 2);
+    if (has_summary()) {
+        draw_summary();
+    }
+    image_buttons_draw(0, summary_height, image_buttons, 2);
     scrollbar_draw(&scrollbar);
 
     graphics_reset_dialog();
@@ -205,6 +302,15 @@ static void handle_input(const mouse *m, const hotkeys *h)
 {
     data.double_click = m->left.double_click;
 
+    if (has_summary()) {
+        save_index_update();
+        if (!data.index_complete && save_index_is_complete()) {
+            // Sort again now that all summaries are known
+            data.index_complete = 1;
+            sort_files();
+        }
+    }
+
     if (input_box_is_accepted(&file_name_input)) {
         button_ok_cancel(1, 0);
         return;
@@ -212,14 +318,18 @@ static void handle_input(const mouse *m, const hotkeys *h)
 
     const mouse *m_dialog = mouse_in_dialog(m);
     data.focus_button_id = 0;
+    data.focus_sort_button = 0;
+    int summary_height = has_summary() ? SUMMARY_HEIGHT : 0;
     if (scrollbar_handle_mouse(&scrollbar, m_dialog) ||
         input_box_handle_mouse(m_dialog, &file_name_input) ||
         generic_buttons_handle_mouse(m_dialog, 0, 0, file_buttons, NUM_FILES_IN_VIEW, &data.focus_button_id) ||
-        image_buttons_handle_mouse(m_dialog, 0, 0, image_buttons, 2, 0)) {
+        (has_summary() && generic_buttons_handle_mouse(m_dialog, 0, 0, &sort_button, 1, &data.focus_sort_button)) ||
+        image_buttons_handle_mouse(m_dialog, 0, summary_height, image_buttons, 2, 0)) {
         return;
     }
     if (input_go_back_requested(m, h)) {
         input_box_stop(&file_name_input);
+        save_index_stop();
         window_go_back();
     }
 
@@ -251,6 +361,7 @@ static void button_ok_cancel(int is_ok, int param2)
 {
     if (!is_ok) {
         input_box_stop(&file_name_input);
+        save_index_stop();
         window_go_back();
         return;
     }
@@ -265,6 +376,7 @@ static void button_ok_cancel(int is_ok, int param2)
         if (data.type == FILE_TYPE_SAVED_GAME) {
             if (game_file_load_saved_game(filename)) {
                 input_box_stop(&file_name_input);
+                save_index_stop();
                 window_city_show();
             } else {
                 data.message_not_exist_start_time = time_get_millis();
@@ -281,6 +393,7 @@ static void button_ok_cancel(int is_ok, int param2)
         }
     } else if (data.dialog_type == FILE_DIALOG_SAVE) {
         input_box_stop(&file_name_input);
+        save_index_stop();
         if (data.type == FILE_TYPE_SAVED_GAME) {
             game_file_write_saved_game(filename);
             window_city_show();
@@ -291,6 +404,7 @@ static void button_ok_cancel(int is_ok, int param2)
     } else if (data.dialog_type == FILE_DIALOG_DELETE) {
         if (game_file_delete_saved_game(filename)) {
             dir_find_files_with_extension(data.file_data->extension);
+            sort_files();
             if (scrollbar.scroll_position + NUM_FILES_IN_VIEW >= data.file_list->num_files) {
                 --scrollbar.scroll_position;
             }
@@ -308,6 +422,17 @@ static void on_scroll(void)
     data.message_not_exist_start_time = 0;
 }
 
+static void button_sort(int param1, int param2)
+{
+    data.sort_mode = (data.sort_mode + 1) % MAX_SORT;
+    if (data.sort_mode == SORT_BY_NAME) {
+        qsort(data.file_list->files, data.file_list->num_files, sizeof(char *), compare_name);
+    } else {
+        sort_files();
+    }
+    scrollbar_reset(&scrollbar, 0);
+}
+
 static void button_select_file(int index, int param2)
 {
     if (index < data.file_list->num_files) {
@@ -54,6 +54,8 @@ static hotkey_widget hotkey_widgets[] = {
     {HOTKEY_RESIZE_TO_1024, TR_HOTKEY_RESIZE_TO_1024},
     {HOTKEY_SAVE_SCREENSHOT, TR_HOTKEY_SAVE_SCREENSHOT},
     {HOTKEY_SAVE_CITY_SCREENSHOT, TR_HOTKEY_SAVE_CITY_SCREENSHOT},
+    {HOTKEY_TOGGLE_PERFORMANCE_HUD, TR_HOTKEY_TOGGLE_PERFORMANCE_HUD},
+    {HOTKEY_SAVE_PERFORMANCE_TRACE, TR_HOTKEY_SAVE_PERFORMANCE_TRACE},
     {HOTKEY_LOAD_FILE, TR_HOTKEY_LOAD_FILE},
     {HOTKEY_SAVE_FILE, TR_HOTKEY_SAVE_FILE},
     {HOTKEY_HEADER, TR_HOTKEY_HEADER_CITY},
@@ -110,6 +112,15 @@ static hotkey_widget hotkey_widgets[] = {
     {HOTKEY_SET_BOOKMARK_2, TR_HOTKEY_SET_BOOKMARK_2},
     {HOTKEY_SET_BOOKMARK_3, TR_HOTKEY_SET_BOOKMARK_3},
     {HOTKEY_SET_BOOKMARK_4, TR_HOTKEY_SET_BOOKMARK_4},
+    {HOTKEY_HEADER, TR_HOTKEY_HEADER_QUICKSAVE},
+    {HOTKEY_QUICKLOAD_1, TR_HOTKEY_QUICKLOAD_1},
+    {HOTKEY_QUICKLOAD_2, TR_HOTKEY_QUICKLOAD_2},
+    {HOTKEY_QUICKLOAD_3, TR_HOTKEY_QUICKLOAD_3},
+    {HOTKEY_QUICKLOAD_4, TR_HOTKEY_QUICKLOAD_4},
+    {HOTKEY_QUICKSAVE_1, TR_HOTKEY_QUICKSAVE_1},
+    {HOTKEY_QUICKSAVE_2, TR_HOTKEY_QUICKSAVE_2},
+    {HOTKEY_QUICKSAVE_3, TR_HOTKEY_QUICKSAVE_3},
+    {HOTKEY_QUICKSAVE_4, TR_HOTKEY_QUICKSAVE_4},
     {HOTKEY_HEADER, TR_HOTKEY_HEADER_EDITOR},
     {HOTKEY_EDITOR_TOGGLE_BATTLE_INFO, TR_HOTKEY_EDITOR_TOGGLE_BATTLE_INFO},
 };
@@ -9,6 +9,7 @@
 #include "graphics/text.h"
 #include "graphics/window.h"
 #include "input/input.h"
+#include "translation/translation.h"
 
 static void button_ok(int param1, int param2);
 static void button_cancel(int param1, int param2);
@@ -60,7 +61,11 @@ static void draw_foreground(void)
     lang_text_draw_centered(45, 1, 128, 266, 224, FONT_NORMAL_GREEN);
     // game speed
     lang_text_draw(45, 2, 112, 146, FONT_NORMAL_PLAIN);
-    text_draw_percentage(setting_game_speed(), 328, 146, FONT_NORMAL_PLAIN);
+    if (setting_game_speed() == GAME_SPEED_UNLIMITED) {
+        text_draw(translation_for(TR_GAME_SPEED_UNLIMITED), 328, 146, FONT_NORMAL_PLAIN, 0);
+    } else {
+        text_draw_percentage(setting_game_speed(), 328, 146, FONT_NORMAL_PLAIN);
+    }
     // scroll speed
     lang_text_draw(45, 3, 112, 182, FONT_NORMAL_PLAIN);
     text_draw_percentage(setting_scroll_speed(), 328, 182, FONT_NORMAL_PLAIN);
@@ -0,0 +1,472 @@
+#include "building/model.h"
+#include "city/view.h"
+#include "core/buffer.h"
+#include "core/config.h"
+#include "core/image.h"
+#include "core/io.h"
+#include "core/time.h"
+#include "game/animation.h"
+#include "game/file.h"
+#include "game/settings.h"
+#include "game/state.h"
+#include "game/system.h"
+#include "graphics/graphics.h"
+#include "graphics/screen.h"
+#include "map/grid.h"
+#include "map/image.h"
+#include "map/property.h"
+#include "map/terrain.h"
+#include "scenario/property.h"
+#include "widget/city_with_overlay.h"
+#include "widget/city_without_overlay.h"
+
+#include "stub/image_groups.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_directory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define make_directory(path) mkdir(path, 0755)
+#endif
+
+#define SCREEN_WIDTH 1024
+#define SCREEN_HEIGHT 768
+#define DEFAULT_FRAMES 100
+#define MILLIS_PER_FRAME 20
+
+// The images are looked up in the language directory first, so the generated ones are written there
+// instead of over the game files in the current directory
+#define SCRATCH_DIR "renderbench-images"
+
+// Layout of the sg2 index, see core/image.c
+#define HEADER_SIZE 20680
+#define ENTRY_SIZE 64
+#define MAIN_ENTRIES 10000
+#define MAIN_INDEX_SIZE (HEADER_SIZE + ENTRY_SIZE * MAIN_ENTRIES)
+#define MAIN_DATA_MAX_SIZE 12000000
+#define EMPIRE_DATA_SIZE (2000 * 1000 * 2)
+
+#define COLOR_555_TRANSPARENT 0x781f
+#define MAX_COMPRESSED_RUN 200
+#define MAX_TRANSPARENT_RUN 255
+
+#define TILE_WIDTH 58
+#define TILE_PIXELS 900
+
+typedef enum {
+    SPRITE_NONE = 0,
+    SPRITE_COMPRESSED = 1,
+    SPRITE_UNCOMPRESSED = 2,
+    SPRITE_ISOMETRIC = 3
+} sprite_type;
+
+typedef struct {
+    sprite_type type;
+    int width;
+    int height;
+    int tiles;
+    int top_height;
+} sprite;
+
+typedef struct {
+    const char *name;
+    int overlay;
+} render_pass;
+
+static const render_pass PASSES[] = {
+    {"city", OVERLAY_NONE},
+    {"water", OVERLAY_WATER},
+    {"religion", OVERLAY_RELIGION},
+    {"fire", OVERLAY_FIRE},
+    {"damage", OVERLAY_DAMAGE},
+    {"crime", OVERLAY_CRIME},
+    {"entertainment", OVERLAY_ENTERTAINMENT},
+    {"education", OVERLAY_EDUCATION},
+    {"clinic", OVERLAY_CLINIC},
+    {"tax_income", OVERLAY_TAX_INCOME},
+    {"food_stocks", OVERLAY_FOOD_STOCKS},
+    {"desirability", OVERLAY_DESIRABILITY},
+    {"native", OVERLAY_NATIVE},
+    {"problems", OVERLAY_PROBLEMS},
+};
+
+#define NUM_PASSES (sizeof(PASSES) / sizeof(render_pass))
+
+// Camera waypoints as a fraction of the map size: a sweep over the whole map followed by a diagonal
+static const struct {
+    int x_percentage;
+    int y_percentage;
+} CAMERA_PATH[] = {
+    {0, 0}, {100, 0}, {100, 50}, {0, 50}, {0, 100}, {100, 100}, {0, 0}
+};
+
+#define CAMERA_PATH_SEGMENTS (sizeof(CAMERA_PATH) / sizeof(CAMERA_PATH[0]) - 1)
+
+// Groups that are drawn as flat isometric tiles by the overlays
+static const int FLAT_TILE_GROUPS[] = {
+    GROUP_TERRAIN_BLACK,
+    GROUP_TERRAIN_GRASS_1,
+    GROUP_TERRAIN_OVERLAY,
+    GROUP_TERRAIN_DESIRABILITY
+};
+
+static struct {
+    int frames;
+    sprite sprites[MAIN_ENTRIES];
+    uint8_t *index_data;
+    uint8_t *pixel_data;
+} data = { DEFAULT_FRAMES };
+
+static uint16_t pixel_color(int image_id, int x, int y)
+{
+    uint32_t hash = (uint32_t) image_id * 2654435761u;
+    uint16_t color = (uint16_t) (((hash >> 8) ^ ((x + y) >> 3)) & 0x7fff);
+    return color == COLOR_555_TRANSPARENT ? color ^ 1 : color;
+}
+
+static int is_opaque(const sprite *s, int x, int y)
+{
+    if (s->type == SPRITE_ISOMETRIC) {
+        int margin = s->width / 4;
+        return x >= margin && x < s->width - margin;
+    }
+    // Ellipse, the usual shape of walkers and building decorations
+    int dx = 2 * x - (s->width - 1);
+    int dy = 2 * y - (s->height - 1);
+    return dx * dx * s->height * s->height + dy * dy * s->width * s->width <= s->width * s->width * s->height * s->height;
+}
+
+static void write_uncompressed(buffer *buf, int image_id, const sprite *s)
+{
+    for (int y = 0; y < s->height; y++) {
+        for (int x = 0; x < s->width; x++) {
+            buffer_write_u16(buf, is_opaque(s, x, y) ? pixel_color(image_id, x, y) : COLOR_555_TRANSPARENT);
+        }
+    }
+}
+
+static void write_compressed(buffer *buf, int image_id, const sprite *s, int y_start, int height)
+{
+    for (int y = y_start; y < y_start + height; y++) {
+        int x = 0;
+        while (x < s->width) {
+            int run = 0;
+            int opaque = is_opaque(s, x, y);
+            int max_run = opaque ? MAX_COMPRESSED_RUN : MAX_TRANSPARENT_RUN;
+            while (x + run < s->width && run < max_run && is_opaque(s, x + run, y) == opaque) {
+                run++;
+            }
+            if (opaque) {
+                buffer_write_u8(buf, (uint8_t) run);
+                for (int i = 0; i < run; i++) {
+                    buffer_write_u16(buf, pixel_color(image_id, x + i, y));
+                }
+            } else {
+                buffer_write_u8(buf, 255);
+                buffer_write_u8(buf, (uint8_t) run);
+            }
+            x += run;
+        }
+    }
+}
+
+static void write_footprint(buffer *buf, int image_id, const sprite *s)
+{
+    for (int tile = 0; tile < s->tiles * s->tiles; tile++) {
+        for (int i = 0; i < TILE_PIXELS; i++) {
+            buffer_write_u16(buf, pixel_color(image_id + tile, i % TILE_WIDTH, i / TILE_WIDTH));
+        }
+    }
+}
+
+static void write_index_entry(buffer *buf, const sprite *s, int data_length, int uncompressed_length)
+{
+    buffer_write_i32(buf, 0);
+    buffer_write_i32(buf, data_length);
+    buffer_write_i32(buf, uncompressed_length);
+    buffer_skip(buf, 8);
+    buffer_write_u16(buf, (uint16_t) s->width);
+    buffer_write_u16(buf, (uint16_t) s->height);
+    buffer_skip(buf, 6);
+    buffer_write_u16(buf, 0); // animation sprites
+    buffer_skip(buf, 2);
+    buffer_write_i16(buf, 0); // sprite offset x
+    buffer_write_i16(buf, 0); // sprite offset y
+    buffer_skip(buf, 10);
+    buffer_write_i8(buf, 0); // animation can reverse
+    buffer_skip(buf, 1);
+    buffer_write_u8(buf, s->type == SPRITE_ISOMETRIC ? IMAGE_TYPE_ISOMETRIC : IMAGE_TYPE_WITH_TRANSPARENCY);
+    buffer_write_i8(buf, s->type == SPRITE_COMPRESSED);
+    buffer_write_i8(buf, 0); // external
+    buffer_write_i8(buf, s->type == SPRITE_ISOMETRIC && s->top_height > 0);
+    buffer_skip(buf, 2);
+    buffer_write_u8(buf, 0); // bitmap
+    buffer_skip(buf, 1);
+    buffer_write_u8(buf, 0); // animation speed
+    buffer_skip(buf, 5);
+}
+
+static int write_sprite_data(buffer *buf, int image_id, const sprite *s, int *uncompressed_length)
+{
+    int start = buf->index;
+    *uncompressed_length = 0;
+    switch (s->type) {
+        case SPRITE_COMPRESSED:
+            write_compressed(buf, image_id, s, 0, s->height);
+            break;
+        case SPRITE_UNCOMPRESSED:
+            write_uncompressed(buf, image_id, s);
+            *uncompressed_length = buf->index - start;
+            break;
+        case SPRITE_ISOMETRIC:
+            write_footprint(buf, image_id, s);
+            *uncompressed_length = buf->index - start;
+            if (s->top_height) {
+                // The top covers the upper half of the footprint as well
+                write_compressed(buf, image_id, s, 0, s->top_height + 15 * s->tiles - 1);
+            }
+            break;
+        default:
+            break;
+    }
+    return buf->index - start;
+}
+
+static int write_atlas(void)
+{
+    buffer index;
+    buffer pixels;
+    memset(data.index_data, 0, MAIN_INDEX_SIZE);
+    buffer_init(&index, data.index_data, MAIN_INDEX_SIZE);
+    buffer_init(&pixels, data.pixel_data, MAIN_DATA_MAX_SIZE);
+
+    buffer_skip(&index, 80);
+    for (int i = 0; i < 300; i++) {
+        buffer_write_u16(&index, (uint16_t) IMAGE_GROUP_IDS[i]);
+    }
+    buffer_set(&index, HEADER_SIZE);
+
+    buffer_write_i32(&pixels, 0); // image data starts at offset 4
+    for (int i = 0; i < MAIN_ENTRIES; i++) {
+        int uncompressed_length;
+        int data_length = write_sprite_data(&pixels, i, &data.sprites[i], &uncompressed_length);
+        if (pixels.overflow) {
+            printf("Synthetic images do not fit in %d bytes\n", MAIN_DATA_MAX_SIZE);
+            return 0;
+        }
+        write_index_entry(&index, &data.sprites[i], data_length, uncompressed_length);
+    }
+    return io_write_buffer_to_file(SCRATCH_DIR "/c3.sg2", data.index_data, MAIN_INDEX_SIZE) &&
+        io_write_buffer_to_file(SCRATCH_DIR "/c3.555", data.pixel_data, pixels.index);
+}
+
+static void set_isometric(int image_id, int tiles, int top_height)
+{
+    if (image_id <= 0 || image_id >= MAIN_ENTRIES) {
+        return;
+    }
+    sprite *s = &data.sprites[image_id];
+    if (s->type == SPRITE_ISOMETRIC && s->tiles >= tiles) {
+        return;
+    }
+    s->type = SPRITE_ISOMETRIC;
+    s->tiles = tiles;
+    s->top_height = top_height;
+    s->width = 60 * tiles - 2;
+    s->height = 30 * tiles + top_height;
+}
+
+static int group_size(int group)
+{
+    int start = IMAGE_GROUP_IDS[group];
+    int end = MAIN_ENTRIES;
+    for (int i = 0; i < 300; i++) {
+        if (IMAGE_GROUP_IDS[i] > start && IMAGE_GROUP_IDS[i] < end) {
+            end = IMAGE_GROUP_IDS[i];
+        }
+    }
+    return end - start;
+}
+
+static void create_default_sprites(void)
+{
+    memset(data.sprites, 0, sizeof(data.sprites));
+    for (int i = 1; i < MAIN_ENTRIES; i++) {
+        sprite *s = &data.sprites[i];
+        s->type = i % 4 ? SPRITE_COMPRESSED : SPRITE_UNCOMPRESSED;
+        s->width = 12 + 4 * (i % 4);
+        s->height = 20 + 6 * (i % 3);
+    }
+    for (int i = 0; i < sizeof(FLAT_TILE_GROUPS) / sizeof(int); i++) {
+        int group = FLAT_TILE_GROUPS[i];
+        int top_height = group == GROUP_TERRAIN_DESIRABILITY ? 20 : 0;
+        for (int id = 0; id < group_size(group); id++) {
+            set_isometric(IMAGE_GROUP_IDS[group] + id, 1, top_height);
+        }
+    }
+}
+
+static void create_map_sprites(void)
+{
+    int width, height;
+    map_grid_size(&width, &height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int grid_offset = map_grid_offset(x, y);
+            if (!map_property_is_draw_tile(grid_offset)) {
+                continue;
+            }
+            int tiles = map_property_multi_tile_size(grid_offset);
+            int has_top = map_terrain_is(grid_offset, TERRAIN_BUILDING | TERRAIN_TREE | TERRAIN_ROCK |
+                TERRAIN_AQUEDUCT | TERRAIN_WALL_OR_GATEHOUSE);
+            set_isometric(map_image_at(grid_offset), tiles, has_top ? 20 + 10 * tiles : 0);
+        }
+    }
+}
+
+static uint64_t checksum_frame(uint64_t hash)
+{
+    int x, y, width, height;
+    city_view_get_viewport(&x, &y, &width, &height);
+    for (int row = y; row < y + height; row++) {
+        const color_t *pixel = graphics_get_pixel(x, row);
+        for (int i = 0; i < width; i++) {
+            hash = (hash ^ pixel[i]) * 1099511628211u;
+        }
+    }
+    return hash;
+}
+
+static void move_camera(int frame)
+{
+    int width, height;
+    map_grid_size(&width, &height);
+    int position = frame * CAMERA_PATH_SEGMENTS * 100 / data.frames;
+    int segment = position / 100;
+    int progress = position % 100;
+    if (segment >= CAMERA_PATH_SEGMENTS) {
+        segment = CAMERA_PATH_SEGMENTS - 1;
+        progress = 100;
+    }
+    int x_percentage = CAMERA_PATH[segment].x_percentage +
+        (CAMERA_PATH[segment + 1].x_percentage - CAMERA_PATH[segment].x_percentage) * progress / 100;
+    int y_percentage = CAMERA_PATH[segment].y_percentage +
+        (CAMERA_PATH[segment + 1].y_percentage - CAMERA_PATH[segment].y_percentage) * progress / 100;
+    city_view_go_to_grid_offset(map_grid_offset((width - 1) * x_percentage / 100, (height - 1) * y_percentage / 100));
+}
+
+static void run_pass(const char *filename, const render_pass *pass)
+{
+    game_state_set_overlay(pass->overlay);
+    city_with_overlay_update();
+    map_tile tile = {0, 0, 0};
+
+    uint64_t hash = 14695981039346656037u;
+    uint64_t total_time = 0;
+    for (int frame = 0; frame < data.frames; frame++) {
+        time_set_millis(frame * MILLIS_PER_FRAME);
+        game_animation_update();
+        move_camera(frame);
+        graphics_clear_screen();
+
+        int x, y, width, height;
+        city_view_get_viewport(&x, &y, &width, &height);
+        graphics_set_clip_rectangle(x, y, width, height);
+        uint64_t start = system_get_time_us();
+        if (pass->overlay) {
+            city_with_overlay_draw(&tile);
+        } else {
+            city_without_overlay_draw(0, 0, &tile);
+        }
+        total_time += system_get_time_us() - start;
+        graphics_reset_clip_rectangle();
+
+        hash = checksum_frame(hash);
+    }
+    printf("%s %-14s %8.3f ms/frame  checksum %016llx\n", filename, pass->name,
+        total_time / 1000.0 / data.frames, (unsigned long long) hash);
+}
+
+static int run_save(const char *filename)
+{
+    // Load with default images first, then size the isometric images to what the map uses
+    create_default_sprites();
+    if (!write_atlas() || !image_load_climate(CLIMATE_CENTRAL, 0, 1)) {
+        printf("Unable to install synthetic images\n");
+        return 0;
+    }
+    if (!game_file_load_saved_game(filename)) {
+        printf("Unable to load saved game %s\n", filename);
+        return 0;
+    }
+    create_map_sprites();
+    if (!write_atlas() || !image_load_climate(CLIMATE_CENTRAL, 0, 1)) {
+        printf("Unable to install synthetic images\n");
+        return 0;
+    }
+    city_view_reset_orientation();
+    for (int i = 0; i < NUM_PASSES; i++) {
+        run_pass(filename, &PASSES[i]);
+    }
+    game_state_reset_overlay();
+    return 1;
+}
+
+static int init(void)
+{
+    settings_load();
+    config_load();
+    if (make_directory(SCRATCH_DIR) != 0 && errno != EEXIST) {
+        printf("Unable to create directory %s\n", SCRATCH_DIR);
+        return 0;
+    }
+    config_set_string(CONFIG_STRING_UI_LANGUAGE_DIR, SCRATCH_DIR);
+    game_state_init();
+    if (!image_init() || !model_load()) {
+        return 0;
+    }
+    data.index_data = (uint8_t *) malloc(MAIN_INDEX_SIZE);
+    data.pixel_data = (uint8_t *) malloc(MAIN_DATA_MAX_SIZE);
+    if (!data.index_data || !data.pixel_data) {
+        return 0;
+    }
+    // The empire image is loaded together with the climate images
+    memset(data.pixel_data, 0, EMPIRE_DATA_SIZE);
+    if (!io_write_buffer_to_file(SCRATCH_DIR "/The_empire.555", data.pixel_data, EMPIRE_DATA_SIZE)) {
+        return 0;
+    }
+    screen_set_resolution(SCREEN_WIDTH, SCREEN_HEIGHT);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    int first_save = 1;
+    if (argc > 2 && strcmp(argv[1], "--frames") == 0) {
+        data.frames = atoi(argv[2]);
+        first_save = 3;
+    }
+    if (first_save >= argc || data.frames <= 0) {
+        printf("Usage: renderbench [--frames N] game.sav...\n");
+        return -1;
+    }
+    if (!init()) {
+        printf("Unable to initialize\n");
+        return 1;
+    }
+    int result = 0;
+    for (int i = first_save; i < argc; i++) {
+        if (!run_save(argv[i])) {
+            result = 1;
+        }
+    }
+    free(data.index_data);
+    free(data.pixel_data);
+    return result;
+}
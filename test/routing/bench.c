@@ -0,0 +1,157 @@
+#include "core/time.h"
+#include "figure/figure.h"
+#include "figure/route.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/settings.h"
+#include "game/system.h"
+#include "map/routing.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_REPEAT 20
+
+static const char *ROUTING_TYPE_NAMES[ROUTING_TYPE_MAX] = {
+    "citizen distances", "water boat", "water flotsam", "building", "delete wall or aqueduct",
+    "citizen land", "citizen road or garden", "walls", "noncitizen land", "noncitizen through everything"
+};
+
+static struct {
+    int ticks;
+    int repeat;
+    figure queries[MAX_FIGURES];
+    int num_queries;
+} data = { 0, DEFAULT_REPEAT };
+
+static void run_ticks(int ticks)
+{
+    setting_reset_speeds(500, setting_scroll_speed());
+    time_set_millis(0);
+    for (int i = 1; i <= ticks; i++) {
+        time_set_millis(2 * i);
+        game_run();
+    }
+}
+
+// Every walking figure with a destination asks figure_route_add() for a path to it
+static void record_queries(void)
+{
+    data.num_queries = 0;
+    for (int i = 1; i < MAX_FIGURES; i++) {
+        const figure *f = figure_get(i);
+        if (f->state != FIGURE_STATE_ALIVE || (!f->destination_x && !f->destination_y)) {
+            continue;
+        }
+        if (f->x == f->destination_x && f->y == f->destination_y) {
+            continue;
+        }
+        data.queries[data.num_queries++] = *f;
+    }
+}
+
+static uint32_t replay_queries(int with_checksum)
+{
+    uint32_t checksum = 2166136261u;
+    for (int i = 0; i < data.num_queries; i++) {
+        figure f = data.queries[i];
+        figure_route_add(&f);
+        if (with_checksum) {
+            for (int tile = 0; tile < f.routing_path_length; tile++) {
+                checksum = (checksum ^ figure_route_get_direction(f.routing_path_id, tile)) * 16777619u;
+            }
+            checksum = (checksum ^ f.routing_path_length) * 16777619u;
+        }
+        figure_route_remove(&f);
+    }
+    return checksum;
+}
+
+static void print_statistics(const figure_route_statistics *paths, const routing_statistics *routing)
+{
+    uint64_t not_found = paths->paths_requested - paths->paths_found - paths->pool_full;
+    printf("  paths: %llu found, %llu not found, %llu pool full, average length %.1f\n",
+        (unsigned long long) paths->paths_found, (unsigned long long) not_found,
+        (unsigned long long) paths->pool_full,
+        paths->paths_found ? (double) paths->total_path_length / paths->paths_found : 0.0);
+
+    for (int type = 0; type < ROUTING_TYPE_MAX; type++) {
+        if (routing->routes[type]) {
+            printf("  %s: %llu routes, %llu tiles expanded, %.1f tiles per route\n",
+                ROUTING_TYPE_NAMES[type], (unsigned long long) routing->routes[type],
+                (unsigned long long) routing->tiles_expanded[type],
+                (double) routing->tiles_expanded[type] / routing->routes[type]);
+        }
+    }
+    printf("  guard hits: %llu\n", (unsigned long long) routing->guard_hits);
+}
+
+static int run_save(const char *filename)
+{
+    if (!game_file_load_saved_game(filename)) {
+        printf("Unable to load saved game %s\n", filename);
+        return 0;
+    }
+    run_ticks(data.ticks);
+    record_queries();
+    int used_paths = figure_route_get_used_paths();
+
+    // Queries are replayed against an empty path pool so that every one of them is routed
+    figure_route_clear_all();
+    figure_route_reset_statistics();
+    map_routing_reset_statistics();
+    uint32_t checksum = replay_queries(1);
+    figure_route_statistics paths = *figure_route_get_statistics();
+    routing_statistics routing = *map_routing_get_statistics();
+
+    uint64_t start = system_get_time_us();
+    for (int i = 0; i < data.repeat; i++) {
+        replay_queries(0);
+    }
+    uint64_t duration = system_get_time_us() - start;
+    double us_per_pass = (double) duration / data.repeat;
+
+    printf("%s: %d queries, path pool %d/%d in use, %.1f us per pass, %.2f us per query, checksum %08x\n",
+        filename, data.num_queries, used_paths, figure_route_get_max_paths(), us_per_pass,
+        data.num_queries ? us_per_pass / data.num_queries : 0.0, checksum);
+    print_statistics(&paths, &routing);
+    return 1;
+}
+
+static int parse_arguments(int argc, char **argv, int *first_save)
+{
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            data.ticks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            data.repeat = atoi(argv[++i]);
+        } else {
+            return 0;
+        }
+    }
+    *first_save = i;
+    return i < argc && data.ticks >= 0 && data.repeat > 0;
+}
+
+int main(int argc, char **argv)
+{
+    int first_save;
+    if (!parse_arguments(argc, argv, &first_save)) {
+        printf("Usage: routingbench [--ticks N] [--repeat N] game.sav...\n");
+        return -1;
+    }
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 1;
+    }
+    int result = 0;
+    for (int i = first_save; i < argc; i++) {
+        if (!run_save(argv[i])) {
+            result = 1;
+        }
+    }
+    game_exit();
+    return result;
+}
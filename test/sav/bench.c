@@ -0,0 +1,338 @@
+#include "core/time.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/settings.h"
+#include "game/system.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_TICKS 1000
+#define DEFAULT_TOLERANCE 10
+#define MAX_SAVES 100
+
+typedef struct {
+    const char *name;
+    int loaded;
+    double ticks_per_second;
+    long long allocations;
+    long long peak_heap_kb;
+} bench_result;
+
+static struct {
+    int ticks;
+    int tolerance;
+    const char *output;
+    const char *baseline;
+    bench_result results[MAX_SAVES];
+    int num_results;
+} data = { DEFAULT_TICKS, DEFAULT_TOLERANCE };
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+// The bench is linked with --wrap for these, so every allocation of the game passes through here.
+// Each block starts with a header holding its size, so that freeing it can shrink the heap size again.
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t num, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t num, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+void __wrap_free(void *ptr);
+
+typedef union {
+    size_t size;
+    // Keeps the memory after the header aligned for any type
+    long double alignment1;
+    long long alignment2;
+    void *alignment3;
+} block_header;
+
+static struct {
+    long long allocations;
+    long long size;
+    long long peak_size;
+} heap;
+
+static void *add_block(block_header *header, size_t size)
+{
+    if (!header) {
+        return 0;
+    }
+    header->size = size;
+    heap.size += size;
+    if (heap.size > heap.peak_size) {
+        heap.peak_size = heap.size;
+    }
+    return header + 1;
+}
+
+static block_header *remove_block(void *ptr)
+{
+    block_header *header = (block_header *) ptr - 1;
+    heap.size -= header->size;
+    return header;
+}
+
+void *__wrap_malloc(size_t size)
+{
+    heap.allocations++;
+    return add_block(__real_malloc(sizeof(block_header) + size), size);
+}
+
+void *__wrap_calloc(size_t num, size_t size)
+{
+    heap.allocations++;
+    if (size && num > (SIZE_MAX - sizeof(block_header)) / size) {
+        return 0;
+    }
+    return add_block(__real_calloc(1, sizeof(block_header) + num * size), num * size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+    heap.allocations++;
+    if (!ptr) {
+        return add_block(__real_malloc(sizeof(block_header) + size), size);
+    }
+    block_header *header = remove_block(ptr);
+    size_t old_size = header->size;
+    block_header *resized = __real_realloc(header, sizeof(block_header) + size);
+    if (!resized) {
+        add_block(header, old_size);
+        return 0;
+    }
+    return add_block(resized, size);
+}
+
+void __wrap_free(void *ptr)
+{
+    if (ptr) {
+        __real_free(remove_block(ptr));
+    }
+}
+
+static long long get_allocations(void)
+{
+    return heap.allocations;
+}
+
+static void reset_peak_heap_size(void)
+{
+    heap.peak_size = heap.size;
+}
+
+static long long get_peak_heap_kb(void)
+{
+    return heap.peak_size / 1024;
+}
+#else
+static long long get_allocations(void)
+{
+    return -1;
+}
+
+static void reset_peak_heap_size(void)
+{
+}
+
+static long long get_peak_heap_kb(void)
+{
+    return -1;
+}
+#endif
+
+static void run_ticks(int ticks)
+{
+    setting_reset_speeds(500, setting_scroll_speed());
+    time_set_millis(0);
+    for (int i = 1; i <= ticks; i++) {
+        time_set_millis(2 * i);
+        game_run();
+    }
+}
+
+static void run_save(bench_result *result)
+{
+    // The peak covers loading the save as well, but not the saves before it
+    reset_peak_heap_size();
+    result->loaded = game_file_load_saved_game(result->name);
+    if (!result->loaded) {
+        printf("Unable to load saved game %s\n", result->name);
+        return;
+    }
+    long long allocations_before = get_allocations();
+    uint64_t start = system_get_time_us();
+    run_ticks(data.ticks);
+    uint64_t duration = system_get_time_us() - start;
+    long long allocations_after = get_allocations();
+
+    result->ticks_per_second = duration ? data.ticks * 1000000.0 / duration : 0;
+    result->allocations = allocations_before < 0 ? -1 : allocations_after - allocations_before;
+    result->peak_heap_kb = get_peak_heap_kb();
+    printf("%s: %.1f ticks/s, %lld allocations, %lld KB peak heap\n",
+        result->name, result->ticks_per_second, result->allocations, result->peak_heap_kb);
+}
+
+static void write_results(FILE *fp)
+{
+    fprintf(fp, "{\n  \"ticks\": %d,\n  \"saves\": [", data.ticks);
+    int first = 1;
+    for (int i = 0; i < data.num_results; i++) {
+        const bench_result *result = &data.results[i];
+        if (!result->loaded) {
+            continue;
+        }
+        fprintf(fp, "%s\n    {\"name\": \"%s\", \"ticks_per_second\": %.1f, \"allocations\": %lld, "
+            "\"peak_heap_kb\": %lld}",
+            first ? "" : ",", result->name, result->ticks_per_second, result->allocations, result->peak_heap_kb);
+        first = 0;
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
+
+static char *read_file(const char *filename)
+{
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *contents = size >= 0 ? malloc(size + 1) : 0;
+    if (contents) {
+        contents[fread(contents, 1, size, fp)] = 0;
+    }
+    fclose(fp);
+    return contents;
+}
+
+static int find_value(const char *entry, const char *key, double *value)
+{
+    char pattern[100];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *end = strchr(entry, '}');
+    const char *found = strstr(entry, pattern);
+    if (!found || (end && found > end)) {
+        return 0;
+    }
+    *value = atof(found + strlen(pattern));
+    return 1;
+}
+
+static const char *find_baseline_entry(const char *baseline, const char *name)
+{
+    char pattern[300];
+    snprintf(pattern, sizeof(pattern), "\"name\": \"%s\"", name);
+    return strstr(baseline, pattern);
+}
+
+static int is_worse(double value, double baseline, int higher_is_better)
+{
+    if (baseline < 0 || value < 0) {
+        return 0;
+    }
+    if (higher_is_better) {
+        return value < baseline * (100 - data.tolerance) / 100;
+    } else {
+        return value > baseline * (100 + data.tolerance) / 100;
+    }
+}
+
+static int compare_value(const bench_result *result, const char *entry, const char *key,
+    double value, int higher_is_better)
+{
+    double baseline;
+    if (!find_value(entry, key, &baseline)) {
+        return 0;
+    }
+    if (is_worse(value, baseline, higher_is_better)) {
+        printf("REGRESSION %s: %s %.1f, baseline %.1f\n", result->name, key, value, baseline);
+        return 1;
+    }
+    return 0;
+}
+
+static int compare_with_baseline(void)
+{
+    char *baseline = read_file(data.baseline);
+    if (!baseline) {
+        printf("Unable to read baseline %s\n", data.baseline);
+        return 1;
+    }
+    int regressions = 0;
+    for (int i = 0; i < data.num_results; i++) {
+        const bench_result *result = &data.results[i];
+        if (!result->loaded) {
+            continue;
+        }
+        const char *entry = find_baseline_entry(baseline, result->name);
+        if (!entry) {
+            printf("No baseline for %s\n", result->name);
+            continue;
+        }
+        regressions += compare_value(result, entry, "ticks_per_second", result->ticks_per_second, 1);
+        regressions += compare_value(result, entry, "allocations", (double) result->allocations, 0);
+        regressions += compare_value(result, entry, "peak_heap_kb", (double) result->peak_heap_kb, 0);
+    }
+    free(baseline);
+    printf("%d regressions against %s (tolerance %d%%)\n", regressions, data.baseline, data.tolerance);
+    return regressions > 0;
+}
+
+static int parse_arguments(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            data.ticks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            data.output = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            data.baseline = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            data.tolerance = atoi(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            return 0;
+        } else if (data.num_results < MAX_SAVES) {
+            data.results[data.num_results++].name = argv[i];
+        }
+    }
+    return data.num_results > 0 && data.ticks > 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (!parse_arguments(argc, argv)) {
+        printf("Usage: bench [--ticks N] [--output file.json] [--baseline file.json] [--tolerance percent] "
+            "game.sav...\n");
+        return -1;
+    }
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 1;
+    }
+    for (int i = 0; i < data.num_results; i++) {
+        run_save(&data.results[i]);
+    }
+    game_exit();
+
+    if (data.output) {
+        FILE *fp = fopen(data.output, "w");
+        if (!fp) {
+            printf("Unable to write %s\n", data.output);
+            return 1;
+        }
+        write_results(fp);
+        fclose(fp);
+    } else {
+        write_results(stdout);
+    }
+    if (data.baseline) {
+        return compare_with_baseline();
+    }
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "sav_compare.h"
+
+#include "../src/core/zip.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DELTA_FILE_VERSION 1
+#define UNCOMPRESSED 0x80000000
+
+static unsigned char data[SAV_MAX_SIZE];
+static unsigned char payload[2 * SAV_MAX_SIZE];
+static unsigned char compress_buffer[2 * SAV_MAX_SIZE];
+
+static unsigned int to_uint(const unsigned char *buffer)
+{
+    return buffer[0] | (buffer[1] << 8) | (buffer[2] << 16) | (buffer[3] << 24);
+}
+
+static int read_int(FILE *fp, unsigned int *value)
+{
+    unsigned char buffer[4];
+    if (fread(buffer, 1, 4, fp) != 4) {
+        return 0;
+    }
+    *value = to_uint(buffer);
+    return 1;
+}
+
+static int read_payload(FILE *fp, unsigned int num_bytes)
+{
+    unsigned int input_size;
+    if (num_bytes > sizeof(payload) || !read_int(fp, &input_size)) {
+        return 0;
+    }
+    if (input_size == UNCOMPRESSED) {
+        return fread(payload, 1, num_bytes, fp) == num_bytes;
+    }
+    int output_size = num_bytes;
+    return input_size <= sizeof(compress_buffer)
+        && fread(compress_buffer, 1, input_size, fp) == input_size
+        && zip_decompress(compress_buffer, input_size, payload, &output_size);
+}
+
+static int apply_record(FILE *fp, int size)
+{
+    unsigned int year, month, num_runs, num_bytes;
+    if (!read_int(fp, &year)) {
+        return 0;
+    }
+    if (!read_int(fp, &month) || !read_int(fp, &num_runs) || !read_int(fp, &num_bytes)
+        || !read_payload(fp, num_bytes)) {
+        printf("Truncated delta record\n");
+        return -1;
+    }
+    unsigned int index = 0;
+    for (unsigned int i = 0; i < num_runs; i++) {
+        if (index + 8 > num_bytes) {
+            printf("Corrupt delta run %u in record for %d.%u\n", i, (int) year, month);
+            return -1;
+        }
+        unsigned int offset = to_uint(&payload[index]);
+        unsigned int length = to_uint(&payload[index + 4]);
+        index += 8;
+        if (offset + length > (unsigned int) size || index + length > num_bytes) {
+            printf("Corrupt delta run %u in record for %d.%u\n", i, (int) year, month);
+            return -1;
+        }
+        memcpy(&data[offset], &payload[index], length);
+        index += length;
+    }
+    printf("Applied %d.%u: %u runs, %u bytes\n", (int) year, month, num_runs, num_bytes);
+    return 1;
+}
+
+static int restore(const char *base, const char *chain, const char *output, int max_months)
+{
+    int size = sav_unpack(base, data);
+    if (!size) {
+        return 1;
+    }
+    FILE *fp = fopen(chain, "rb");
+    if (!fp) {
+        printf("Unable to open file %s\n", chain);
+        return 1;
+    }
+    unsigned int version, chain_size;
+    if (!read_int(fp, &version) || !read_int(fp, &chain_size)
+        || version != DELTA_FILE_VERSION || chain_size != (unsigned int) size) {
+        printf("Delta chain %s does not match base %s\n", chain, base);
+        fclose(fp);
+        return 1;
+    }
+    int months = 0;
+    while (max_months < 0 || months < max_months) {
+        int result = apply_record(fp, size);
+        if (result < 0) {
+            fclose(fp);
+            return 1;
+        } else if (result == 0) {
+            break;
+        }
+        months++;
+    }
+    fclose(fp);
+    if (months < max_months) {
+        printf("Chain only contains %d months\n", months);
+        return 1;
+    }
+    return sav_pack(output, data) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 4 && argc != 5) {
+        printf("Usage: %s BASE_SAV DELTA_CHAIN OUTPUT_SAV [MONTHS]\n", argv[0]);
+        return 1;
+    }
+    int months = argc == 5 ? atoi(argv[4]) : -1;
+    return restore(argv[1], argv[2], argv[3], months);
+}
@@ -0,0 +1,19 @@
+# Writes a delta autosave chain while running a saved game, rebuilds the last month from the chain and
+# compares it with the expected full save. Run with cmake -P and the variables AUTOPILOT, SAVDELTA, COMPARE,
+# INPUT_SAV, EXPECTED_SAV and TICKS set.
+
+string(REPLACE ".sav" "-delta" delta_name ${EXPECTED_SAV})
+string(REPLACE ".sav" "-delta-actual.sav" output_sav ${EXPECTED_SAV})
+string(REPLACE ".sav" "-delta-restored.sav" restored_sav ${EXPECTED_SAV})
+file(REMOVE ${delta_name}.sav ${delta_name}.delta ${output_sav} ${restored_sav})
+
+function(run_step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed: ${ARGN}")
+    endif()
+endfunction(run_step)
+
+run_step(${AUTOPILOT} --delta-autosave ${delta_name} ${INPUT_SAV} ${output_sav} ${EXPECTED_SAV} ${TICKS})
+run_step(${SAVDELTA} ${delta_name}.sav ${delta_name}.delta ${restored_sav})
+run_step(${COMPARE} ${restored_sav} ${EXPECTED_SAV})
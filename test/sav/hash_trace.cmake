@@ -0,0 +1,16 @@
+# Runs a saved game twice: the first run records a hash trace, the second one must match it on every tick.
+# Run with cmake -P and the variables AUTOPILOT, INPUT_SAV, EXPECTED_SAV and TICKS set.
+
+string(REPLACE ".sav" "-hashes.txt" trace ${EXPECTED_SAV})
+string(REPLACE ".sav" "-hashed.sav" output_sav ${EXPECTED_SAV})
+file(REMOVE ${trace} ${output_sav})
+
+function(run_step)
+    execute_process(COMMAND ${ARGN} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed: ${ARGN}")
+    endif()
+endfunction(run_step)
+
+run_step(${AUTOPILOT} --hash-trace ${trace} ${INPUT_SAV} ${output_sav} ${EXPECTED_SAV} ${TICKS})
+run_step(${AUTOPILOT} --hash-compare ${trace} ${INPUT_SAV} ${output_sav} ${EXPECTED_SAV} ${TICKS})
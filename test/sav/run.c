@@ -1,8 +1,10 @@
 #include "core/backtrace.h"
+#include "core/file.h"
 #include "core/time.h"
 #include "game/file.h"
 #include "game/game.h"
 #include "game/settings.h"
+#include "game/state_hash.h"
 
 #ifdef _MSC_VER
 #include <direct.h>
@@ -15,8 +17,22 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "sav_compare.h"
 
+#define MAX_HASH_LINE 1024
+
+static struct {
+    FILE *trace;
+    FILE *reference;
+    int diverged;
+} hashes;
+
+static struct {
+    char base[FILE_NAME_MAX];
+    char chain[FILE_NAME_MAX];
+} delta_autosave;
+
 static void handler(int sig)
 {
     fprintf(stderr, "Oops, crashed with signal %d :(", sig);
@@ -24,14 +40,122 @@ static void handler(int sig)
     exit(1);
 }
 
+static const char *hash_header(void)
+{
+    static char header[MAX_HASH_LINE];
+    if (!header[0]) {
+        int length = snprintf(header, MAX_HASH_LINE, "tick total");
+        for (int i = 0; i < STATE_HASH_MAX; i++) {
+            length += snprintf(&header[length], MAX_HASH_LINE - length, " %s", state_hash_part_name(i));
+        }
+        snprintf(&header[length], MAX_HASH_LINE - length, "\n");
+    }
+    return header;
+}
+
+static void write_hash_line(FILE *fp, int tick, const state_hash *hash)
+{
+    fprintf(fp, "%d %016llx", tick, (unsigned long long) hash->total);
+    for (int i = 0; i < STATE_HASH_MAX; i++) {
+        fprintf(fp, " %016llx", (unsigned long long) hash->parts[i]);
+    }
+    fprintf(fp, "\n");
+}
+
+static int read_hash_line(FILE *fp, int *tick, state_hash *hash)
+{
+    char line[MAX_HASH_LINE];
+    if (!fgets(line, MAX_HASH_LINE, fp)) {
+        return 0;
+    }
+    char *next = line;
+    *tick = (int) strtol(next, &next, 10);
+    hash->total = strtoull(next, &next, 16);
+    for (int i = 0; i < STATE_HASH_MAX; i++) {
+        hash->parts[i] = strtoull(next, &next, 16);
+    }
+    return 1;
+}
+
+static int open_hash_reference(const char *filename)
+{
+    hashes.reference = fopen(filename, "r");
+    if (!hashes.reference) {
+        printf("Unable to read hash trace %s\n", filename);
+        return 0;
+    }
+    char header[MAX_HASH_LINE];
+    if (!fgets(header, MAX_HASH_LINE, hashes.reference) || strcmp(header, hash_header()) != 0) {
+        printf("Hash trace %s does not hash the same parts of the state\n", filename);
+        fclose(hashes.reference);
+        hashes.reference = 0;
+        return 0;
+    }
+    return 1;
+}
+
+static void compare_hash(int tick, const state_hash *hash)
+{
+    int expected_tick;
+    state_hash expected;
+    if (!read_hash_line(hashes.reference, &expected_tick, &expected) || expected_tick != tick) {
+        printf("Hash trace ends before tick %d\n", tick);
+        fclose(hashes.reference);
+        hashes.reference = 0;
+        return;
+    }
+    if (expected.total == hash->total) {
+        return;
+    }
+    printf("State diverged from the hash trace at tick %d in:", tick);
+    for (int i = 0; i < STATE_HASH_MAX; i++) {
+        if (expected.parts[i] != hash->parts[i]) {
+            printf(" %s", state_hash_part_name(i));
+        }
+    }
+    printf("\n");
+    // Everything after the first difference differs as well
+    hashes.diverged = 1;
+    fclose(hashes.reference);
+    hashes.reference = 0;
+}
+
+static void hash_tick(int tick)
+{
+    if (!hashes.trace && !hashes.reference) {
+        return;
+    }
+    state_hash hash;
+    state_hash_calculate(&hash);
+    if (hashes.trace) {
+        write_hash_line(hashes.trace, tick, &hash);
+    }
+    if (hashes.reference) {
+        compare_hash(tick, &hash);
+    }
+}
+
 static void run_ticks(int ticks)
 {
     setting_reset_speeds(500, setting_scroll_speed());
     time_set_millis(0);
+    hash_tick(0);
     for (int i = 1; i <= ticks; i++) {
         time_set_millis(2 * i);
         game_run();
+        hash_tick(i);
+    }
+}
+
+static int write_delta_autosave(void)
+{
+    // The first call after loading writes the base, the next ones append a record to the chain
+    printf("Writing delta autosave to %s and %s\n", delta_autosave.base, delta_autosave.chain);
+    if (!game_file_write_delta_autosave(delta_autosave.base, delta_autosave.chain)) {
+        printf("Unable to write delta autosave\n");
+        return 0;
     }
+    return 1;
 }
 
 static int run_autopilot(const char *input_saved_game, const char *output_saved_game, int ticks_to_run)
@@ -58,7 +182,13 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
         }
         return 3;
     }
+    if (delta_autosave.base[0] && !write_delta_autosave()) {
+        return 4;
+    }
     run_ticks(ticks_to_run);
+    if (delta_autosave.base[0] && !write_delta_autosave()) {
+        return 4;
+    }
     printf("Saving game to %s\n", output_saved_game);
     game_file_write_saved_game(output_saved_game);
     printf("Done\n");
@@ -68,18 +198,57 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
     return 0;
 }
 
+static int parse_hash_options(int argc, char **argv)
+{
+    int i = 1;
+    for (; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+        if (strcmp(argv[i], "--hash-trace") == 0) {
+            hashes.trace = fopen(argv[i + 1], "w");
+            if (!hashes.trace) {
+                printf("Unable to write hash trace %s\n", argv[i + 1]);
+                return -1;
+            }
+            fputs(hash_header(), hashes.trace);
+        } else if (strcmp(argv[i], "--hash-compare") == 0) {
+            if (!open_hash_reference(argv[i + 1])) {
+                return -1;
+            }
+        } else if (strcmp(argv[i], "--delta-autosave") == 0) {
+            snprintf(delta_autosave.base, FILE_NAME_MAX, "%s.sav", argv[i + 1]);
+            snprintf(delta_autosave.chain, FILE_NAME_MAX, "%s.delta", argv[i + 1]);
+        } else {
+            printf("Unknown option %s\n", argv[i]);
+            return -1;
+        }
+    }
+    return i;
+}
+
+// Usage: autopilot [--hash-trace out.txt] [--hash-compare reference.txt] [--delta-autosave name]
+// input.sav output.sav expected.sav ticks
 int main(int argc, char **argv)
 {
-    if (argc != 5) {
+    int first = parse_hash_options(argc, argv);
+    if (first < 0) {
+        return -1;
+    }
+    if (argc - first != 4) {
         printf("Incorrect number of arguments (%d)\n", argc);
         return -1;
     }
-    const char *input = argv[1];
-    const char *output = argv[2];
-    const char *expected = argv[3];
-    int ticks = atoi(argv[4]);
-    if (run_autopilot(input, output, ticks) == 0) {
-        return compare_files(expected, output);
+    const char *input = argv[first];
+    const char *output = argv[first + 1];
+    const char *expected = argv[first + 2];
+    int ticks = atoi(argv[first + 3]);
+    int result = run_autopilot(input, output, ticks);
+    if (hashes.trace) {
+        fclose(hashes.trace);
+    }
+    if (hashes.reference) {
+        fclose(hashes.reference);
+    }
+    if (result == 0) {
+        return compare_files(expected, output) || hashes.diverged;
     } else {
         return 1;
     }
@@ -233,12 +233,13 @@ static struct game_file_part save_game_parts[] = {
     {0, 32, "bookmarks"},
     {0, 4, "tutorial_part3"},
     {0, 8, "city_entry_exit_grid_offset"},
+    {0, 284, "end_marker"},
     {0, 0, ""},
 };
 
 static char compress_buffer[COMPRESS_BUFFER_SIZE];
-static unsigned char file1_data[1300000];
-static unsigned char file2_data[1300000];
+static unsigned char file1_data[SAV_MAX_SIZE];
+static unsigned char file2_data[SAV_MAX_SIZE];
 
 static unsigned int to_uint(const unsigned char *buffer)
 {
@@ -250,6 +251,14 @@ static unsigned int to_ushort(const unsigned char *buffer)
     return buffer[0] | (buffer[1] << 8);
 }
 
+static void from_uint(unsigned int value, unsigned char *buffer)
+{
+    buffer[0] = value & 0xff;
+    buffer[1] = (value >> 8) & 0xff;
+    buffer[2] = (value >> 16) & 0xff;
+    buffer[3] = (value >> 24) & 0xff;
+}
+
 static int index_of_part(const char *part_name)
 {
     for (int i = 0; save_game_parts[i].length_in_bytes; i++) {
@@ -296,7 +305,23 @@ static int read_compressed_chunk(FILE *fp, void *buffer, int bytes_to_read)
     return 1;
 }
 
-static int unpack(const char *filename, unsigned char *buffer)
+static void write_compressed_chunk(FILE *fp, const void *buffer, int bytes_to_write)
+{
+    unsigned char intbuf[4];
+    int output_size = COMPRESS_BUFFER_SIZE;
+    if (bytes_to_write <= COMPRESS_BUFFER_SIZE
+        && zip_compress(buffer, bytes_to_write, compress_buffer, &output_size)) {
+        from_uint(output_size, intbuf);
+        fwrite(intbuf, 1, 4, fp);
+        fwrite(compress_buffer, 1, output_size, fp);
+    } else {
+        from_uint(UNCOMPRESSED, intbuf);
+        fwrite(intbuf, 1, 4, fp);
+        fwrite(buffer, 1, bytes_to_write, fp);
+    }
+}
+
+int sav_unpack(const char *filename, unsigned char *buffer)
 {
     FILE *fp = fopen(filename, "rb");
     if (!fp) {
@@ -312,7 +337,8 @@ static int unpack(const char *filename, unsigned char *buffer)
             result = fread(&buffer[offset], 1, save_game_parts[i].length_in_bytes, fp) == save_game_parts[i].length_in_bytes;
         }
         offset += save_game_parts[i].length_in_bytes;
-        if (!result) {
+        // The last piece may be smaller than its length
+        if (!result && save_game_parts[i + 1].length_in_bytes) {
             printf("Error while loading file %s\n", filename);
             fclose(fp);
             return 0;
@@ -322,6 +348,26 @@ static int unpack(const char *filename, unsigned char *buffer)
     return offset;
 }
 
+int sav_pack(const char *filename, const unsigned char *buffer)
+{
+    FILE *fp = fopen(filename, "wb");
+    if (!fp) {
+        printf("Unable to write file %s\n", filename);
+        return 0;
+    }
+    int offset = 0;
+    for (int i = 0; save_game_parts[i].length_in_bytes; i++) {
+        if (save_game_parts[i].compressed) {
+            write_compressed_chunk(fp, &buffer[offset], save_game_parts[i].length_in_bytes);
+        } else {
+            fwrite(&buffer[offset], 1, save_game_parts[i].length_in_bytes, fp);
+        }
+        offset += save_game_parts[i].length_in_bytes;
+    }
+    fclose(fp);
+    return offset;
+}
+
 static int has_adjacent_terrain_type(int part_offset, int terrain_type)
 {
     int grid_offset = part_offset / 2;
@@ -477,6 +523,9 @@ static int is_exception(int index, int global_offset, int part_offset)
     if (index == index_of_part("camera")) {
         return 1;
     }
+    if (index == index_of_part("end_marker")) {
+        return 1;
+    }
     if (index == index_of_part("image_grid")) {
         return is_exception_image_grid(global_offset, part_offset);
     }
@@ -579,8 +628,8 @@ static int compare(void)
 
 int compare_files(const char *file1, const char *file2)
 {
-    int length1 = unpack(file1, file1_data);
-    int length2 = unpack(file2, file2_data);
+    int length1 = sav_unpack(file1, file1_data);
+    int length2 = sav_unpack(file2, file2_data);
     if (length1 && length1 == length2) {
         return compare();
     } else {
@@ -1,6 +1,24 @@
 #ifndef SAV_COMPARE_H
 #define SAV_COMPARE_H
 
+#define SAV_MAX_SIZE 1300000
+
 int compare_files(const char *file1, const char *file2);
 
+/**
+ * Reads a saved game into one uncompressed buffer, pieces laid out back to back
+ * @param filename Saved game to read
+ * @param buffer Buffer of at least SAV_MAX_SIZE bytes
+ * @return Number of bytes unpacked, 0 on error
+ */
+int sav_unpack(const char *filename, unsigned char *buffer);
+
+/**
+ * Writes an uncompressed buffer as produced by sav_unpack back to a saved game
+ * @param filename Saved game to write
+ * @param buffer Buffer with the uncompressed pieces
+ * @return Number of bytes packed, 0 on error
+ */
+int sav_pack(const char *filename, const unsigned char *buffer);
+
 #endif // SAV_COMPARE_H
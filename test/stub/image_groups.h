@@ -0,0 +1,38 @@
+#ifndef TEST_STUB_IMAGE_GROUPS_H
+#define TEST_STUB_IMAGE_GROUPS_H
+
+// First image ID of each image group in the original c3.sg2
+static const int IMAGE_GROUP_IDS[] = {
+    0, 245, 254, 246, 274, 364, 444, 476, 534, 201,
+    306, 871, 886, 949, 1438, 892, 1439, 696, 2780, 666,
+    548, 733, 2872, 2830, 699, 2863, 2779, 2785, 2791, 2797,
+    2803, 2809, 2813, 2817, 2819, 2821, 2823, 2883, 2914, 2925,
+    2932, 2954, 2955, 2956, 2957, 3039, 3051, 7972, 3074, 3089,
+    3100, 3119, 3129, 2831, 2839, 2847, 2855, 3410, 3140, 3148,
+    3024, 3155, 3158, 3164, 3165, 2943, 3176, 3183, 3184, 3185,
+    3208, 3209, 3211, 3213, 3215, 3217, 3219, 3226, 3230, 3277,
+    7777, 3281, 3319, 3337, 3338, 2824, 2825, 2826, 3514, 955,
+    967, 3618, 993, 1104, 1108, 7737, 1109, 4650, 3722, 3011,
+    2884, 3826, 5354, 5362, 4026, 4130, 4234, 4338, 4442, 3930,
+    4546, 5579, 591, 5777, 658, 5929, 6041, 6193, 6489, 734,
+    743, 6345, 2970, 2979, 2988, 3003, 5374, 5422, 1125, 1186,
+    4794, 4778, 1205, 1349, 1398, 581, 7776, 1053, 262, 5432,
+    5440, 7798, 7806, 7810, 7814, 7816, 7820, 7824, 7825, 7829,
+    7834, 7835, 7837, 5446, 5452, 5457, 5462, 945, 926, 7839,
+    7969, 7970, 7971, 6609, 3292, 4890, 3181, 4922, 3242, 3254,
+    3266, 3306, 7973, 7982, 8003, 8010, 8017, 8031, 8039, 8071,
+    8073, 8090, 8098, 2827, 3318, 3196, 8126, 8127, 8128, 1414,
+    8129, 3073, 3050, 3088, 6705, 7763, 681, 7764, 5467, 1150,
+    5515, 3182, 6849, 7049, 7161, 821, 779, 825, 1417, 5018,
+    3029, 3197, 3207, 7780, 7789, 8192, 845, 5122, 5186, 5250,
+    5258, 3163, 1433, 8024, 8055, 1204, 4914, 5571, 7425, 7321,
+    7529, 7633, 8376, 8528, 8640, 8800, 7001, 5266, 3402, 849,
+    863, 5401, 5572, 8000, 8953, 8954, 8966, 7953, 5577, 8944,
+    8288, 9008, 8967, 7772, 8963, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+#endif // TEST_STUB_IMAGE_GROUPS_H
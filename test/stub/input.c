@@ -1,4 +1,3 @@
-#include "game/system.h"
 #include "input/hotkey.h"
 #include "input/keys.h"
 #include "input/mouse.h"
@@ -18,11 +17,6 @@ int key_combination_from_name(const char *name, key_type *key, key_modifier_type
     return 0;
 }
 
-key_type system_keyboard_key_for_symbol(const char *name)
-{
-    return KEY_TYPE_NONE;
-}
-
 void mouse_reset_up_state(void)
 {
 }
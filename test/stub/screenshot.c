@@ -0,0 +1,4 @@
+#include "graphics/screenshot.h"
+
+void graphics_save_screenshot(int full_city)
+{}
@@ -39,3 +39,13 @@ void sound_device_stop_music(void)
 
 void sound_device_stop_channel(int channel)
 {}
+
+void sound_device_use_custom_music_player(int bitdepth, int num_channels, int rate,
+                                          const unsigned char *data, int len)
+{}
+
+void sound_device_write_custom_music_data(const unsigned char *data, int len)
+{}
+
+void sound_device_use_default_music_player(void)
+{}
@@ -0,0 +1,101 @@
+#include "game/system.h"
+
+#include <stdlib.h>
+#include <time.h>
+
+static color_t *framebuffer;
+
+const char *system_version(void)
+{
+    return "test";
+}
+
+void system_resize(int width, int height)
+{}
+
+void system_center(void)
+{}
+
+int system_is_fullscreen_only(void)
+{
+    return 0;
+}
+
+void system_set_fullscreen(int fullscreen)
+{}
+
+int system_scale_display(int scale_percentage)
+{
+    return 100;
+}
+
+int system_can_scale_display(int *min_scale, int *max_scale)
+{
+    return 0;
+}
+
+void system_init_cursors(int scale_percentage)
+{}
+
+void system_set_cursor(int cursor_id)
+{}
+
+key_type system_keyboard_key_for_symbol(const char *name)
+{
+    return KEY_TYPE_NONE;
+}
+
+const char *system_keyboard_key_name(key_type key)
+{
+    return "";
+}
+
+const char *system_keyboard_key_modifier_name(key_modifier_type modifier)
+{
+    return "";
+}
+
+void system_keyboard_set_input_rect(int x, int y, int width, int height)
+{}
+
+void system_keyboard_show(void)
+{}
+
+void system_keyboard_hide(void)
+{}
+
+void system_start_text_input(void)
+{}
+
+void system_stop_text_input(void)
+{}
+
+void system_mouse_set_relative_mode(int enabled)
+{}
+
+void system_mouse_get_relative_state(int *x, int *y)
+{
+    *x = 0;
+    *y = 0;
+}
+
+void system_move_mouse_cursor(int delta_x, int delta_y)
+{}
+
+void system_set_mouse_position(int *x, int *y)
+{}
+
+color_t *system_create_framebuffer(int width, int height)
+{
+    free(framebuffer);
+    framebuffer = (color_t *) malloc((size_t) width * height * sizeof(color_t));
+    return framebuffer;
+}
+
+uint64_t system_get_time_us(void)
+{
+    return (uint64_t) clock() * 1000000 / CLOCKS_PER_SEC;
+}
+
+void system_exit(void)
+{}
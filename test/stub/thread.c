@@ -0,0 +1,55 @@
+#include "core/thread.h"
+
+thread *thread_create(int (*function)(void *), void *data, const char *name)
+{
+    return 0;
+}
+
+int thread_get_cpu_count(void)
+{
+    return 1;
+}
+
+unsigned long thread_current_id(void)
+{
+    return 0;
+}
+
+int thread_wait(thread *t)
+{
+    return 0;
+}
+
+thread_mutex *thread_mutex_create(void)
+{
+    return 0;
+}
+
+void thread_mutex_lock(thread_mutex *mutex)
+{
+}
+
+void thread_mutex_unlock(thread_mutex *mutex)
+{
+}
+
+void thread_mutex_destroy(thread_mutex *mutex)
+{
+}
+
+thread_semaphore *thread_semaphore_create(int value)
+{
+    return 0;
+}
+
+void thread_semaphore_post(thread_semaphore *semaphore)
+{
+}
+
+void thread_semaphore_wait(thread_semaphore *semaphore)
+{
+}
+
+void thread_semaphore_destroy(thread_semaphore *semaphore)
+{
+}